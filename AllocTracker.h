@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+// --- Alloc Tracker ---
+// Opt-in heap accounting for finding allocations in the frame loop. Building with
+// HELLFIRE_TRACK_ALLOCS replaces the global operator new/delete, and every allocation in the
+// process is then counted three ways: in total, per thread (Game diffs this around each frame
+// and tick), and per subsystem scope, meaning the innermost TRACE_SCOPE or ALLOC_SCOPE active on
+// the allocating thread. Without the macro nothing is replaced and all counters read zero.
+namespace AllocTracker {
+#ifdef HELLFIRE_TRACK_ALLOCS
+    const bool enabled = true;
+#else
+    const bool enabled = false;
+#endif
+    const int MAX_SCOPES = 128; // Scopes beyond this are counted in the totals only
+
+    struct Counters {
+        std::uint64_t count = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    struct ScopeStats {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    std::atomic<std::uint64_t> totalCount{0};
+    std::atomic<std::uint64_t> totalBytes{0};
+    thread_local Counters threadCounters;
+    thread_local const char* currentScope = nullptr;
+    ScopeStats scopes[MAX_SCOPES];
+
+    // Running totals of the calling thread; subtract two readings to get what happened in between
+    Counters thisThread() { return threadCounters; }
+
+    Counters since(const Counters& start) {
+        Counters delta;
+        delta.count = threadCounters.count - start.count;
+        delta.bytes = threadCounters.bytes - start.bytes;
+        return delta;
+    }
+
+    // Open-addressed by name pointer (names are string literals). Never allocates, so it is safe
+    // to call from operator new.
+    ScopeStats* findScope(const char* name) {
+        std::size_t slot = (reinterpret_cast<std::uintptr_t>(name) >> 3) % MAX_SCOPES;
+        for (int probe = 0; probe < MAX_SCOPES; ++probe) {
+            ScopeStats& s = scopes[(slot + probe) % MAX_SCOPES];
+            const char* owner = s.name.load(std::memory_order_acquire);
+            if (owner == name) return &s;
+            if (owner == nullptr) {
+                const char* expected = nullptr;
+                if (s.name.compare_exchange_strong(expected, name, std::memory_order_acq_rel) || expected == name) return &s;
+            }
+        }
+        return nullptr;
+    }
+
+    void recordAllocation(std::size_t size) {
+        totalCount.fetch_add(1, std::memory_order_relaxed);
+        totalBytes.fetch_add(size, std::memory_order_relaxed);
+        ++threadCounters.count;
+        threadCounters.bytes += size;
+        if (currentScope) {
+            if (ScopeStats* s = findScope(currentScope)) {
+                s->count.fetch_add(1, std::memory_order_relaxed);
+                s->bytes.fetch_add(size, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Attributes this thread's allocations to `name` until the end of the enclosing block
+    class Scope {
+    public:
+        explicit Scope(const char* name) : previous(currentScope) { currentScope = name; }
+        ~Scope() { currentScope = previous; }
+
+    private:
+        const char* previous;
+    };
+
+    // Every scope that allocated since startup, most allocations first
+    void print(std::ostream& out) {
+        if (!enabled) return;
+        const ScopeStats* order[MAX_SCOPES];
+        int used = 0;
+        for (const ScopeStats& s : scopes) {
+            if (s.name.load() && s.count.load()) order[used++] = &s;
+        }
+        std::sort(order, order + used, [](const ScopeStats* a, const ScopeStats* b) { return a->count.load() > b->count.load(); });
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "Heap allocations: %llu (%.1f KB) in total\n",
+                      static_cast<unsigned long long>(totalCount.load()), totalBytes.load() / 1024.0);
+        out << line;
+        for (int i = 0; i < used; ++i) {
+            std::snprintf(line, sizeof(line), "  %-40s %10llu allocs %12.1f KB\n", order[i]->name.load(),
+                          static_cast<unsigned long long>(order[i]->count.load()), order[i]->bytes.load() / 1024.0);
+            out << line;
+        }
+    }
+}
+
+#ifdef HELLFIRE_TRACK_ALLOCS
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+#define ALLOC_SCOPE(name) AllocTracker::Scope ALLOC_CONCAT(allocScope_, __LINE__)(name)
+
+// Plain malloc underneath; only the counting is added
+void* operator new(std::size_t size) {
+    AllocTracker::recordAllocation(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,337 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#include "FighterAI.h"
+#include "FighterSim.h"
+#include "MatchEnv.h"
+#include "Trace.h"
+
+// --- Bot Link ---
+// Lets a bot in another process (a Python prototype, say) play matches through POSIX shared
+// memory instead of a socket. The segment holds one channel per match. In each channel the game
+// writes an observation (MatchEnv's layout) into a ring of slots and bumps `observationSeq`; the
+// bot answers with an AIOption index and sets `actionSeq` to the sequence it answers. Both
+// sequence words are futexes, so either side can sleep on the other without polling or a syscall
+// per byte moved.
+//
+// Layout, native endian, everything 64-byte aligned, for readers in other languages:
+//   BotSegmentHeader                      (magic "HFBT", version, sizes below)
+//   BotChannel[channelCount], each:
+//     uint32 observationSeq  + padding    cache line 0
+//     uint32 actionSeq, int32 action      cache line 1
+//     BotSlot[ringSlots]: uint32 seq, uint32 done, float reward, float observation[observationSize]
+// Slot `seq % ringSlots` holds observation `seq` (starting at 1). A slot's seq reads 0 while it is
+// being written; copy it out and check seq again to be sure it wasn't overwritten meanwhile.
+//
+// Two hosts use it: the live game (the "Bot" difficulty: BotAI below never waits for an answer
+// and keeps playing the last action it got), and bot_match.cpp, which steps headless MatchEnv
+// matches in lockstep with the bot. Linux only (futex); elsewhere create()/attach() return false
+// and error() says why.
+
+const std::uint32_t BOT_LINK_MAGIC = 0x54424648; // "HFBT"
+const std::uint32_t BOT_LINK_VERSION = 1;
+const int BOT_RING_SLOTS = 64;
+
+struct alignas(64) BotSegmentHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t channelCount;
+    std::uint32_t ringSlots;
+    std::uint32_t observationSize;
+    std::uint32_t actionCount;
+    std::uint32_t slotBytes;
+    std::uint32_t channelBytes;
+};
+
+struct BotSlot {
+    std::atomic<std::uint32_t> seq;
+    std::uint32_t done;   // MatchEnv::RUNNING, KNOCKOUT or TIMEOUT
+    float reward;         // For the step that led here
+    float observation[MatchEnv::OBS_SIZE];
+};
+
+struct alignas(64) BotChannel {
+    alignas(64) std::atomic<std::uint32_t> observationSeq; // Game -> bot
+    alignas(64) std::atomic<std::uint32_t> actionSeq;      // Bot -> game: the observation `action` answers
+    std::atomic<std::int32_t> action;
+    alignas(64) BotSlot slots[BOT_RING_SLOTS];
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "BotLink needs address-free 32-bit atomics");
+
+class BotLink {
+public:
+    BotLink() = default;
+    ~BotLink() { close(); }
+    BotLink(const BotLink&) = delete;
+    BotLink& operator=(const BotLink&) = delete;
+
+    // Game/host side: makes (or remakes) the segment `name` ("/hellfire_bot") with `channels` matches
+    bool create(const std::string& name, int channels) {
+#if defined(__linux__)
+        close();
+        std::size_t bytes = sizeof(BotSegmentHeader) + sizeof(BotChannel) * static_cast<std::size_t>(channels);
+        int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) return fail("shm_open");
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            return fail("ftruncate");
+        }
+        if (!map(fd, bytes)) return false;
+
+        std::memset(base, 0, bytes);
+        header()->version = BOT_LINK_VERSION;
+        header()->channelCount = static_cast<std::uint32_t>(channels);
+        header()->ringSlots = BOT_RING_SLOTS;
+        header()->observationSize = MatchEnv::OBS_SIZE;
+        header()->actionCount = MatchEnv::ACTION_SIZE;
+        header()->slotBytes = sizeof(BotSlot);
+        header()->channelBytes = sizeof(BotChannel);
+        std::atomic_thread_fence(std::memory_order_release);
+        header()->magic = BOT_LINK_MAGIC; // Last, so a bot attaching early never sees half a header
+        segmentName = name;
+        owner = true;
+        return true;
+#else
+        (void)name;
+        (void)channels;
+        lastError = "BotLink needs Linux (POSIX shared memory and futexes)";
+        return false;
+#endif
+    }
+
+    // Bot side: maps a segment the game already created
+    bool attach(const std::string& name) {
+#if defined(__linux__)
+        close();
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) return fail("shm_open");
+        off_t bytes = lseek(fd, 0, SEEK_END);
+        if (bytes < static_cast<off_t>(sizeof(BotSegmentHeader))) {
+            ::close(fd);
+            lastError = "segment too small";
+            return false;
+        }
+        if (!map(fd, static_cast<std::size_t>(bytes))) return false;
+        const BotSegmentHeader* h = header();
+        if (h->magic != BOT_LINK_MAGIC || h->version != BOT_LINK_VERSION || h->observationSize != MatchEnv::OBS_SIZE ||
+            h->channelBytes != sizeof(BotChannel)) {
+            close();
+            lastError = "segment layout doesn't match this build";
+            return false;
+        }
+        segmentName = name;
+        return true;
+#else
+        (void)name;
+        lastError = "BotLink needs Linux (POSIX shared memory and futexes)";
+        return false;
+#endif
+    }
+
+    void close() {
+#if defined(__linux__)
+        if (base) munmap(base, mappedBytes);
+        if (owner) shm_unlink(segmentName.c_str());
+#endif
+        base = nullptr;
+        mappedBytes = 0;
+        owner = false;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    const std::string& error() const { return lastError; }
+    int channelCount() const { return base ? static_cast<int>(header()->channelCount) : 0; }
+
+    // --- Game side ---
+
+    // Writes the next observation for `channel` and wakes a waiting bot; returns its sequence
+    std::uint32_t publish(int channel, const float* observation, float reward, std::uint8_t done) {
+        BotChannel& c = channelAt(channel);
+        std::uint32_t seq = c.observationSeq.load(std::memory_order_relaxed) + 1;
+        if (seq == 0) seq = 1; // 0 marks a slot being written
+        BotSlot& slot = c.slots[seq % BOT_RING_SLOTS];
+        slot.seq.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.done = done;
+        slot.reward = reward;
+        std::memcpy(slot.observation, observation, sizeof(slot.observation));
+        slot.seq.store(seq, std::memory_order_release);
+        c.observationSeq.store(seq, std::memory_order_release);
+        wake(c.observationSeq);
+        return seq;
+    }
+
+    // Lockstep: sleeps until the bot has answered observation `seq`, or `timeout` passes
+    bool waitAction(int channel, std::uint32_t seq, std::chrono::microseconds timeout, int& action) {
+        BotChannel& c = channelAt(channel);
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            std::uint32_t answered = c.actionSeq.load(std::memory_order_acquire);
+            if (answered == seq) {
+                action = c.action.load(std::memory_order_relaxed);
+                return true;
+            }
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero()) return false;
+            wait(c.actionSeq, answered, std::chrono::duration_cast<std::chrono::microseconds>(left));
+        }
+    }
+
+    // Never blocks: the most recent action and which observation it answered (0: none yet)
+    std::uint32_t latestAction(int channel, int& action) const {
+        const BotChannel& c = channelAt(channel);
+        std::uint32_t answered = c.actionSeq.load(std::memory_order_acquire);
+        action = c.action.load(std::memory_order_relaxed);
+        return answered;
+    }
+
+    // --- Bot side ---
+
+    // Sleeps until an observation newer than `after` exists, then copies the newest one into `out`.
+    // Returns its sequence, or 0 on timeout.
+    std::uint32_t waitObservation(int channel, std::uint32_t after, std::chrono::microseconds timeout,
+                                  float* observation, float& reward, std::uint8_t& done) {
+        BotChannel& c = channelAt(channel);
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            std::uint32_t seq = c.observationSeq.load(std::memory_order_acquire);
+            if (seq != after && seq != 0) {
+                const BotSlot& slot = c.slots[seq % BOT_RING_SLOTS];
+                if (slot.seq.load(std::memory_order_acquire) == seq) {
+                    reward = slot.reward;
+                    done = static_cast<std::uint8_t>(slot.done);
+                    std::memcpy(observation, slot.observation, sizeof(slot.observation));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (slot.seq.load(std::memory_order_relaxed) == seq) return seq;
+                }
+                continue; // Overwritten while we copied; take the newer one
+            }
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero()) return 0;
+            wait(c.observationSeq, seq, std::chrono::duration_cast<std::chrono::microseconds>(left));
+        }
+    }
+
+    void submitAction(int channel, std::uint32_t seq, int action) {
+        BotChannel& c = channelAt(channel);
+        c.action.store(action, std::memory_order_relaxed);
+        c.actionSeq.store(seq, std::memory_order_release);
+        wake(c.actionSeq);
+    }
+
+private:
+    void* base = nullptr;
+    std::size_t mappedBytes = 0;
+    bool owner = false;
+    std::string segmentName;
+    std::string lastError;
+
+    BotSegmentHeader* header() const { return static_cast<BotSegmentHeader*>(base); }
+
+    BotChannel& channelAt(int channel) const {
+        return reinterpret_cast<BotChannel*>(static_cast<char*>(base) + sizeof(BotSegmentHeader))[channel];
+    }
+
+#if defined(__linux__)
+    bool map(int fd, std::size_t bytes) {
+        void* mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return fail("mmap");
+        base = mapped;
+        mappedBytes = bytes;
+        return true;
+    }
+
+    bool fail(const char* what) {
+        lastError = std::string(what) + ": " + std::strerror(errno);
+        return false;
+    }
+
+    // Shared (not FUTEX_PRIVATE) operations: the other side lives in another process
+    static void wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::microseconds timeout) {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000) * 1000;
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+    }
+
+    static void wake(std::atomic<std::uint32_t>& word) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+#else
+    static void wait(std::atomic<std::uint32_t>&, std::uint32_t, std::chrono::microseconds) {}
+    static void wake(std::atomic<std::uint32_t>&) {}
+#endif
+};
+
+// --- Bot AI ---
+// The "Bot" difficulty: the enemy is played by whatever process is attached to the game's
+// BotLink. Every decide() publishes this tick's observation and plays the latest answer; the
+// simulation tick never waits for the bot, so a slow or missing bot just reacts late (or stands
+// still until its first answer arrives).
+class BotAI : public FighterAI {
+public:
+    BotLink* link;
+    int channel;
+    AIOption current = AIOption::IDLE;
+    int ticks = 0;
+    std::uint32_t lastAnswered = 0;
+    std::uint64_t published = 0;
+    std::uint64_t answered = 0; // Distinct answers received
+
+    BotAI(BotLink* sharedLink, int channelIndex = 0) : link(sharedLink), channel(channelIndex) {}
+
+    void reset() override {
+        current = AIOption::IDLE;
+        ticks = 0;
+        healthBefore = opponentHealthBefore = -1.f;
+    }
+
+    void decide(const Character& self, const Character& opponent, FighterInput& out) override {
+        TRACE_SCOPE("BotAI::decide");
+        MatchState match = FighterSim::capture(opponent, self); // We are side 1, as in MatchEnv
+        int roundTicks = static_cast<int>(GameConfig::GAME_ROUND_DURATION * GameConfig::SIMULATION_TICK_RATE);
+        float observation[MatchEnv::OBS_SIZE];
+        MatchEnv::writeObservation(match, 1, std::max(0.f, 1.f - static_cast<float>(ticks++) / roundTicks), observation);
+
+        float reward = 0.f;
+        if (healthBefore >= 0.f) {
+            reward = ((opponentHealthBefore - opponent.currentHealth) - (healthBefore - self.currentHealth)) / GameConfig::MAX_HEALTH;
+        }
+        healthBefore = self.currentHealth;
+        opponentHealthBefore = opponent.currentHealth;
+        std::uint8_t done = !self.isAlive || !opponent.isAlive ? MatchEnv::KNOCKOUT : MatchEnv::RUNNING;
+        link->publish(channel, observation, reward, done);
+        ++published;
+
+        int action = 0;
+        std::uint32_t seq = link->latestAction(channel, action);
+        if (seq != lastAnswered) {
+            lastAnswered = seq;
+            ++answered;
+            current = static_cast<AIOption>(std::min(std::max(action, 0), AI_OPTION_COUNT - 1));
+        }
+
+        AIPerception p = AIPerception::observe(self, opponent);
+        pressOption(current, p.dx, p.facingOpponent, out);
+    }
+
+private:
+    float healthBefore = -1.f;
+    float opponentHealthBefore = -1.f;
+};
@@ -1,28 +1,40 @@
 #pragma once
 #include "Enums.h"
-#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
 #include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 #include "GameConfig.h"
 #include "ResourceManager.h"
 #include "Utils.h"
+#include "Input.h"
+#include "SimClock.h"
 #include <SFML/Graphics.hpp>
+#include "RenderStats.h"
+#include "Palette.h"
 
-// Forward declaration for Character::Action (enum inside Character class)
-class Character;
+// Animations per Character::Action, indexed in the order of that enum
+const int ACTION_COUNT = 9;
+
+// One action's sprite sheet: `frames` equal-width frames laid out left to right
+struct ActionSheet {
+    std::string path;
+    int frames;
+    float frameSeconds; // How long each frame stays up
+};
 
 struct CharacterPreset {
     CharacterTypeID type;
     std::string name;
     std::string titlePath; // Path to title image
-    
-    // Paths to individual action textures
-    std::string idlePath, runPath, jumpPath, attack1Path, attack2Path, attack3Path, shieldPath, hurtPath, deadPath;
-    
-    // Frame counts for each action
-    int idleFrames, runFrames, jumpFrames, attack1Frames, attack2Frames, attack3Frames, shieldFrames, hurtFrames, deadFrames;
-    
-    // Animation speeds for each action
-    float idleSpeed, runSpeed, jumpSpeed, attackSpeed, hurtSpeed, deadSpeed;
+
+    // Idle, run, jump, attack 1-3, shield, hurt, dead (Character::Action order)
+    ActionSheet sheets[ACTION_COUNT];
     float spriteScale;
 };
 
@@ -31,24 +43,368 @@ struct CharacterPreset {
 const std::map<CharacterTypeID, CharacterPreset> AllCharacterPresets = {
     {CharacterTypeID::KNIGHT, {
         CharacterTypeID::KNIGHT, "Knight", "assets/char1_title.png",
-        "assets/Idle.png", "assets/Run.png", "assets/Jump.png", "assets/Attack_1.png", "assets/Attack_2.png", "assets/Attack_3.png", "assets/Shield.png", "assets/Hurt.png", "assets/Dead.png",
-        6, 8, 10, 4, 3, 4, 2, 3, 3,
-        0.15f, 0.08f, 0.1f, 0.1f, GameConfig::HURT_DURATION / 3.f, 0.15f, 2.6f
+        {{"assets/Idle.png", 6, 0.15f}, {"assets/Run.png", 8, 0.08f}, {"assets/Jump.png", 10, 0.1f},
+         {"assets/Attack_1.png", 4, 0.1f}, {"assets/Attack_2.png", 3, 0.1f}, {"assets/Attack_3.png", 4, 0.1f},
+         {"assets/Shield.png", 2, 0.15f}, {"assets/Hurt.png", 3, GameConfig::HURT_DURATION / 3.f}, {"assets/Dead.png", 3, 0.15f}},
+        2.6f
     }},
     {CharacterTypeID::ROGUE, {
         CharacterTypeID::ROGUE, "Rogue", "assets/Enemy_title.png",
-        "assets/Enemy_Idle.png", "assets/Enemy_Run.png", "assets/Enemy_Jump.png", "assets/Enemy_Attack_1.png", "assets/Enemy_Attack_2.png", "assets/Enemy_Attack_3.png", "assets/Enemy_Shield.png", "assets/Enemy_Hurt.png", "assets/Enemy_Dead.png",
-        6, 8, 12, 6, 4, 3, 2, 2, 3,
-        0.15f, 0.08f, 0.1f, 0.1f, GameConfig::HURT_DURATION / 2.f, 0.15f, 2.5f
+        {{"assets/Enemy_Idle.png", 6, 0.15f}, {"assets/Enemy_Run.png", 8, 0.08f}, {"assets/Enemy_Jump.png", 12, 0.1f},
+         {"assets/Enemy_Attack_1.png", 6, 0.1f}, {"assets/Enemy_Attack_2.png", 4, 0.1f}, {"assets/Enemy_Attack_3.png", 3, 0.1f},
+         {"assets/Enemy_Shield.png", 2, 0.15f}, {"assets/Enemy_Hurt.png", 2, GameConfig::HURT_DURATION / 2.f}, {"assets/Enemy_Dead.png", 3, 0.15f}},
+        2.5f
     }},
     {CharacterTypeID::SAMURAI, {
         CharacterTypeID::SAMURAI, "Samurai", "assets/S_title.png",
-        "assets/S_Idle.png", "assets/S_Run.png", "assets/S_Jump.png", "assets/S_Attack_1.png", "assets/S_Attack_2.png", "assets/S_Attack_3.png", "assets/S_Shield.png", "assets/S_Hurt.png", "assets/S_Dead.png",
-        6, 8, 9, 4, 5, 4, 2, 3, 6,
-        0.15f, 0.08f, 0.1f, 0.1f, GameConfig::HURT_DURATION / 3.f, 0.15f, 2.7f
+        {{"assets/S_Idle.png", 6, 0.15f}, {"assets/S_Run.png", 8, 0.08f}, {"assets/S_Jump.png", 9, 0.1f},
+         {"assets/S_Attack_1.png", 4, 0.1f}, {"assets/S_Attack_2.png", 5, 0.1f}, {"assets/S_Attack_3.png", 4, 0.1f},
+         {"assets/S_Shield.png", 2, 0.15f}, {"assets/S_Hurt.png", 3, GameConfig::HURT_DURATION / 3.f}, {"assets/S_Dead.png", 6, 0.15f}},
+        2.7f
     }}
 };
 
+// --- Animation Table ---
+// Everything needed to play a preset's animations, worked out once when the preset is first
+// loaded: per action the sheet, each frame's rect and duration, and what happens after the last
+// frame. Advancing an animation is then a lookup into the clip instead of a switch per action.
+// Tables are cached per preset and shared by every fighter using it (and by FighterSim).
+
+// What an animation does once its last frame has been shown
+enum class AnimationEnd : std::uint8_t {
+    LOOP, // Start over (idle, run, jump, shield)
+    HOLD, // Stay on the last frame (hurt, dead)
+    NEXT  // Hand over to `next` (attacks, which end the swing and return to idle)
+};
+
+// --- Frame Mask ---
+// One bit per screen pixel of a frame as drawn (opaque or not), for the pixel-precise hit mode.
+// Rows are whole 64-bit words, so testing two masks against each other is an AND per word over the
+// rows they share instead of a pixel-by-pixel walk over the images.
+struct FrameMask {
+    int left = 0, top = 0;       // Bit (0, 0) relative to the fighter's position, in screen pixels
+    int width = 0, height = 0;
+    int words = 0;               // Words per row
+    std::vector<std::uint64_t> bits;
+
+    void create(int maskLeft, int maskTop, int maskWidth, int maskHeight) {
+        left = maskLeft;
+        top = maskTop;
+        width = std::max(maskWidth, 0);
+        height = std::max(maskHeight, 0);
+        words = (width + 63) / 64;
+        bits.assign(static_cast<std::size_t>(words) * height, 0);
+    }
+
+    void set(int x, int y) { bits[static_cast<std::size_t>(y) * words + x / 64] |= std::uint64_t(1) << (x % 64); }
+
+    // 64 bits of row `y` starting at column `x` (which may be negative or past the end: those read as 0)
+    std::uint64_t span(int y, int x) const {
+        const std::uint64_t* row = &bits[static_cast<std::size_t>(y) * words];
+        int word = x >= 0 ? x / 64 : (x - 63) / 64;
+        int shift = x - word * 64;
+        std::uint64_t low = word >= 0 && word < words ? row[word] : 0;
+        std::uint64_t high = word + 1 >= 0 && word + 1 < words ? row[word + 1] : 0;
+        return shift == 0 ? low : (low >> shift) | (high << (64 - shift));
+    }
+
+    // The whole screen pixels a rect touches
+    static sf::IntRect covering(const sf::FloatRect& area) {
+        int left = static_cast<int>(std::floor(area.left)), top = static_cast<int>(std::floor(area.top));
+        return sf::IntRect(left, top, static_cast<int>(std::ceil(area.left + area.width)) - left,
+                           static_cast<int>(std::ceil(area.top + area.height)) - top);
+    }
+
+    // Whether `a` drawn at `aAt` and `b` drawn at `bAt` (fighter positions, rounded to whole
+    // pixels) have an opaque pixel in common inside `area` (screen pixels)
+    static bool overlap(const FrameMask& a, sf::Vector2i aAt, const FrameMask& b, sf::Vector2i bAt, const sf::IntRect& area) {
+        int ax = aAt.x + a.left, ay = aAt.y + a.top;
+        int bx = bAt.x + b.left, by = bAt.y + b.top;
+        int x0 = std::max({area.left, ax, bx});
+        int x1 = std::min({area.left + area.width, ax + a.width, bx + b.width});
+        int y0 = std::max({area.top, ay, by});
+        int y1 = std::min({area.top + area.height, ay + a.height, by + b.height});
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; x += 64) {
+                std::uint64_t both = a.span(y - ay, x - ax) & b.span(y - by, x - bx);
+                if (x1 - x < 64) both &= (std::uint64_t(1) << (x1 - x)) - 1;
+                if (both) return true;
+            }
+        }
+        return false;
+    }
+};
+
+struct AnimationClip {
+    static const int MAX_FRAMES = 16;
+
+    const sf::Texture* texture = nullptr; // The preset's atlas; nullptr in measured (texture-free) tables
+    int frameCount = 0;
+    sf::IntRect frames[MAX_FRAMES];       // Each frame's full cell on its sheet: the fighter's bounds
+    sf::IntRect trims[MAX_FRAMES];        // The cell's opaque pixels, relative to the cell
+    // Each frame as drawn, per facing ([0] left, [1] right): the trimmed pixels scaled to screen
+    // size and placed relative to the fighter's position, which is the cell's top-left whichever
+    // way it faces. Facing left mirrors the offsets and texture coordinates, so nothing is
+    // transformed per tick and the transparent margins are never drawn.
+    sf::Vertex quads[MAX_FRAMES][2][4];
+    sf::FloatRect hurtboxes[MAX_FRAMES][2]; // Body area per facing, relative to the position like the quads
+    FrameMask masks[MAX_FRAMES][2];       // Opaque pixels per facing at screen scale, for pixel-precise hits
+    float durations[MAX_FRAMES] = {};
+    float length = 0.f;                   // All durations together
+    AnimationEnd end = AnimationEnd::LOOP;
+    int next = 0;                         // Action index played after the last frame when end is NEXT
+};
+
+struct AnimationTable {
+    static const int ATLAS_WIDTH = 1024;      // Trimmed frames are packed into rows this wide
+    static constexpr float BODY_COLUMN_SHARE = 0.25f; // Columns this full (vs the fullest) count as body
+
+    AnimationClip clips[ACTION_COUNT];
+    int frameHeight = 100; // The idle sheet's height; every frame cell uses it
+    sf::Texture atlas;     // Every trimmed frame of every action (load() only), as palette indices when `indexed`
+    sf::Texture palette;   // The preset's colours, one row per costume (see Palette.h)
+    bool indexed = false;  // Draw with PaletteShader; false without shaders or with more than 256 colours
+
+    // Sheets trimmed into one atlas texture, for fighters that draw
+    static const AnimationTable& load(CharacterTypeID type) {
+        return cached(type, true);
+    }
+
+    // The same table without the texture (sheets are decoded on the CPU by sf::Image), for
+    // matches without a window or GL context. Identical to load() apart from the missing atlas.
+    static const AnimationTable& measure(CharacterTypeID type) {
+        return cached(type, false);
+    }
+
+private:
+    static const AnimationTable& cached(CharacterTypeID type, bool withTextures) {
+        static std::mutex mutex;
+        static std::map<std::pair<CharacterTypeID, bool>, AnimationTable> tables; // Nodes never move, so references stay valid
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = tables.find({type, withTextures});
+        if (found != tables.end()) return found->second;
+        AnimationTable& table = tables[{type, withTextures}];
+        table.build(AllCharacterPresets.at(type), withTextures);
+        return table;
+    }
+
+    // Sheets are uniform strips with wide transparent margins. Each frame is trimmed to its opaque
+    // pixels, which are packed into the atlas (shelf by shelf, a pixel apart so filtering never
+    // bleeds) and drawn at their offset in the cell. The body is the run of columns that are at
+    // least BODY_COLUMN_SHARE as full as the fullest, so a thin blade or a stray pixel doesn't
+    // widen the hurtbox; its height is the opaque rows inside those columns.
+    void build(const CharacterPreset& preset, bool withTextures) {
+        TRACE_SCOPE_DETAIL("AnimationTable::build", preset.name);
+        FlightRecorder::AssetLoad flightLoad("AnimationTable::build", preset.name);
+        static const AnimationEnd ends[ACTION_COUNT] = {
+            AnimationEnd::LOOP, AnimationEnd::LOOP, AnimationEnd::LOOP,
+            AnimationEnd::NEXT, AnimationEnd::NEXT, AnimationEnd::NEXT,
+            AnimationEnd::LOOP, AnimationEnd::HOLD, AnimationEnd::HOLD
+        };
+        bool loaded = true;
+        std::vector<sf::Image> sheets(ACTION_COUNT);
+        for (int i = 0; i < ACTION_COUNT; ++i) {
+            bool found = sheets[i].loadFromFile(preset.sheets[i].path) && sheets[i].getSize().x > 0;
+            if (!found) std::cerr << "Failed to load texture: " << preset.sheets[i].path << std::endl;
+            loaded &= found;
+        }
+        if (sheets[0].getSize().y > 0) frameHeight = static_cast<int>(sheets[0].getSize().y);
+
+        // Cells, trims, bodies and atlas places
+        sf::IntRect bodies[ACTION_COUNT][AnimationClip::MAX_FRAMES];
+        sf::Vector2i places[ACTION_COUNT][AnimationClip::MAX_FRAMES];
+        int shelfX = 0, shelfY = 0, shelfHeight = 0;
+        std::vector<int> columns; // measureFrame scratch, sized to the widest cell
+        for (int i = 0; i < ACTION_COUNT; ++i) {
+            const ActionSheet& sheet = preset.sheets[i];
+            AnimationClip& clip = clips[i];
+            // Missing sheets get 100px frames so bounds and hitboxes stay sane
+            int width = sheets[i].getSize().x > 0 ? static_cast<int>(sheets[i].getSize().x) / sheet.frames : 100;
+            clip.frameCount = std::min(sheet.frames, AnimationClip::MAX_FRAMES);
+            for (int f = 0; f < clip.frameCount; ++f) {
+                clip.frames[f] = sf::IntRect(f * width, 0, width, frameHeight);
+                measureFrame(sheets[i], clip.frames[f], clip.trims[f], bodies[i][f], columns);
+                clip.durations[f] = std::max(sheet.frameSeconds, 0.001f);
+                clip.length += clip.durations[f];
+
+                const sf::IntRect& trim = clip.trims[f];
+                if (shelfX + trim.width > ATLAS_WIDTH) {
+                    shelfX = 0;
+                    shelfY += shelfHeight + 1;
+                    shelfHeight = 0;
+                }
+                places[i][f] = sf::Vector2i(shelfX, shelfY);
+                shelfX += trim.width + 1;
+                shelfHeight = std::max(shelfHeight, trim.height);
+            }
+            clip.end = ends[i];
+            clip.next = 0;
+        }
+
+        if (withTextures) {
+            sf::Image packed;
+            packed.create(ATLAS_WIDTH, static_cast<unsigned>(std::max(shelfY + shelfHeight, 1)), sf::Color::Transparent);
+            for (int i = 0; i < ACTION_COUNT; ++i) {
+                if (sheets[i].getSize().x == 0) continue;
+                for (int f = 0; f < clips[i].frameCount; ++f) {
+                    sf::IntRect source = clips[i].trims[f];
+                    source.left += clips[i].frames[f].left;
+                    packed.copy(sheets[i], places[i][f].x, places[i][f].y, source);
+                }
+            }
+            indexed = PaletteShader::isAvailable() && indexColors(packed);
+            atlas.loadFromImage(packed);
+            ResourceManager::trackTexture(atlas);
+        }
+
+        float scale = preset.spriteScale;
+        for (int i = 0; i < ACTION_COUNT; ++i) {
+            AnimationClip& clip = clips[i];
+            clip.texture = withTextures ? &atlas : nullptr;
+            for (int f = 0; f < clip.frameCount; ++f) {
+                const sf::IntRect& cell = clip.frames[f];
+                const sf::IntRect& trim = clip.trims[f];
+                const sf::IntRect& body = bodies[i][f];
+                float u0 = static_cast<float>(places[i][f].x), u1 = u0 + trim.width;
+                float v0 = static_cast<float>(places[i][f].y), v1 = v0 + trim.height;
+                float w = trim.width * scale, h = trim.height * scale, top = trim.top * scale;
+                for (int right = 0; right < 2; ++right) {
+                    // Facing left, a pixel `x` from the cell's left edge is drawn `x` from its right edge
+                    float left = (right ? trim.left : cell.width - trim.left - trim.width) * scale;
+                    float ul = right ? u0 : u1, ur = right ? u1 : u0;
+                    sf::Vertex* quad = clip.quads[f][right];
+                    quad[0] = sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(ul, v0));
+                    quad[1] = sf::Vertex(sf::Vector2f(left + w, top), sf::Vector2f(ur, v0));
+                    quad[2] = sf::Vertex(sf::Vector2f(left + w, top + h), sf::Vector2f(ur, v1));
+                    quad[3] = sf::Vertex(sf::Vector2f(left, top + h), sf::Vector2f(ul, v1));
+
+                    float bodyLeft = right ? body.left : cell.width - body.left - body.width;
+                    clip.hurtboxes[f][right] = sf::FloatRect(bodyLeft * scale, body.top * scale, body.width * scale, body.height * scale);
+
+                    buildMask(sheets[i], cell, trim, scale, right != 0, quad[0].position, clip.masks[f][right]);
+                }
+            }
+        }
+        if (!loaded) {
+            std::cerr << "CRITICAL: Failed to load one or more " << preset.name << " character textures." << std::endl;
+        }
+    }
+
+    // Swaps the atlas's colours for palette indices (red = index, alpha unchanged) and builds the
+    // palette texture: the colours in the order they first appear, recoloured once per costume.
+    // Leaves the atlas alone and returns false if the preset uses more colours than an index holds.
+    bool indexColors(sf::Image& packed) {
+        const std::uint8_t* pixels = packed.getPixelsPtr();
+        if (!pixels) return false;
+        std::size_t count = static_cast<std::size_t>(packed.getSize().x) * packed.getSize().y;
+        std::vector<std::uint8_t> indices(count * 4, 0);
+        std::vector<sf::Color> colors;
+        std::map<std::uint32_t, std::uint8_t> lookup;
+        for (std::size_t p = 0; p < count; ++p) {
+            const std::uint8_t* pixel = pixels + p * 4;
+            if (pixel[3] == 0) continue;
+            std::uint32_t key = pixel[0] | (pixel[1] << 8) | (pixel[2] << 16);
+            auto found = lookup.find(key);
+            if (found == lookup.end()) {
+                if (colors.size() == 256) return false;
+                found = lookup.emplace(key, static_cast<std::uint8_t>(colors.size())).first;
+                colors.push_back(sf::Color(pixel[0], pixel[1], pixel[2]));
+            }
+            indices[p * 4] = found->second;
+            indices[p * 4 + 3] = pixel[3];
+        }
+
+        sf::Image rows;
+        rows.create(static_cast<unsigned>(std::max<std::size_t>(colors.size(), 1)), COSTUME_COUNT, sf::Color::Black);
+        for (int costume = 0; costume < COSTUME_COUNT; ++costume) {
+            for (std::size_t c = 0; c < colors.size(); ++c) {
+                rows.setPixel(static_cast<unsigned>(c), costume, applyCostume(colors[c], Costumes[costume]));
+            }
+        }
+        palette.loadFromImage(rows);
+        ResourceManager::trackTexture(palette);
+        packed.create(packed.getSize().x, packed.getSize().y, indices.data());
+        return true;
+    }
+
+    // Samples the trimmed frame at screen scale: each mask pixel is opaque if the sheet pixel
+    // drawn over its centre is. `origin` is the top-left of the frame's quad for this facing.
+    // Without pixels (stub or missing sheet) the whole trimmed rect counts as opaque.
+    static void buildMask(const sf::Image& sheet, const sf::IntRect& cell, const sf::IntRect& trim, float scale,
+                          bool right, sf::Vector2f origin, FrameMask& mask) {
+        int left = static_cast<int>(std::floor(origin.x));
+        int top = static_cast<int>(std::floor(origin.y));
+        mask.create(left, top, static_cast<int>(std::ceil(origin.x + trim.width * scale)) - left,
+                    static_cast<int>(std::ceil(origin.y + trim.height * scale)) - top);
+        const std::uint8_t* pixels = sheet.getPixelsPtr();
+        int stride = static_cast<int>(sheet.getSize().x);
+        for (int y = 0; y < mask.height; ++y) {
+            int sheetY = static_cast<int>((top + y + 0.5f) / scale);
+            if (sheetY < trim.top || sheetY >= trim.top + trim.height) continue;
+            if (pixels && sheetY >= static_cast<int>(sheet.getSize().y)) continue;
+            for (int x = 0; x < mask.width; ++x) {
+                int cellX = static_cast<int>((left + x + 0.5f) / scale);
+                if (!right) cellX = cell.width - 1 - cellX;
+                if (cellX < trim.left || cellX >= trim.left + trim.width) continue;
+                if (pixels && pixels[(static_cast<std::size_t>(sheetY) * stride + cell.left + cellX) * 4 + 3] == 0) continue;
+                mask.set(x, y);
+            }
+        }
+    }
+
+    // Opaque bounds and body of one cell, both relative to the cell. A cell with nothing opaque
+    // (or no sheet) keeps its full rect and the old padded-rectangle body: the middle 35% of the
+    // width, 10% to 90% of the height. `columns` is scratch space reused from frame to frame, so
+    // cells of any width are measured in full.
+    static void measureFrame(const sf::Image& sheet, const sf::IntRect& cell, sf::IntRect& trim, sf::IntRect& body,
+                             std::vector<int>& columns) {
+        trim = sf::IntRect(0, 0, cell.width, cell.height);
+        float bodyWidth = cell.width * 0.35f;
+        body = sf::IntRect(static_cast<int>((cell.width - bodyWidth) / 2.f), static_cast<int>(cell.height * 0.1f),
+                           static_cast<int>(bodyWidth), static_cast<int>(cell.height * 0.8f));
+        const std::uint8_t* pixels = sheet.getPixelsPtr();
+        if (!pixels) return;
+
+        int stride = static_cast<int>(sheet.getSize().x);
+        int rows = std::min(cell.height, static_cast<int>(sheet.getSize().y));
+        int cellWidth = cell.width;
+        columns.assign(static_cast<std::size_t>(cellWidth), 0);
+        int minX = cellWidth, maxX = -1, minY = rows, maxY = -1, fullest = 0;
+        for (int y = 0; y < rows; ++y) {
+            const std::uint8_t* row = pixels + (static_cast<std::size_t>(y) * stride + cell.left) * 4;
+            for (int x = 0; x < cellWidth; ++x) {
+                if (row[x * 4 + 3] == 0) continue;
+                ++columns[x];
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+                minY = std::min(minY, y);
+                maxY = std::max(maxY, y);
+            }
+        }
+        if (maxX < 0) return;
+        trim = sf::IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+
+        for (int x = minX; x <= maxX; ++x) fullest = std::max(fullest, columns[x]);
+        int bodyMinX = maxX, bodyMaxX = minX;
+        for (int x = minX; x <= maxX; ++x) {
+            if (columns[x] < fullest * BODY_COLUMN_SHARE) continue;
+            bodyMinX = std::min(bodyMinX, x);
+            bodyMaxX = std::max(bodyMaxX, x);
+        }
+        int bodyMinY = maxY, bodyMaxY = minY;
+        for (int y = minY; y <= maxY; ++y) {
+            const std::uint8_t* row = pixels + (static_cast<std::size_t>(y) * stride + cell.left) * 4;
+            for (int x = bodyMinX; x <= bodyMaxX; ++x) {
+                if (row[x * 4 + 3] == 0) continue;
+                bodyMinY = std::min(bodyMinY, y);
+                bodyMaxY = std::max(bodyMaxY, y);
+                break;
+            }
+        }
+        body = sf::IntRect(bodyMinX, bodyMinY, bodyMaxX - bodyMinX + 1, bodyMaxY - bodyMinY + 1);
+    }
+};
+
 // --- Character Base Class (Common properties for Player and Enemy) ---
 class Character {
 public:
@@ -57,7 +413,6 @@ public:
     // `charType` declared at the top of the class
     CharacterTypeID charType; 
 
-    sf::Sprite sprite;
     Action currentAction = Action::IDLE;
     Action previousAction = Action::IDLE;
     bool facingRight = true;
@@ -68,34 +423,27 @@ public:
     bool isAlive = true;
     bool dealtDamageThisAttack = false;
     bool isDamageFlashing = false;
-    sf::Clock damageFlashTimer;
+    SimClock damageFlashTimer;
 
     float verticalVelocity = 0.0f;
     int currentFrame = 0;
     float animTime = 0.0f;
-    sf::Clock attackCooldownClock;
+    SimClock attackCooldownClock;
     bool canAttack = true;
-    sf::Clock hurtClock;
+    SimClock hurtClock;
 
     float maxHealth = GameConfig::MAX_HEALTH;
     float currentHealth = GameConfig::MAX_HEALTH;
     std::string name;
 
-    // Character-specific textures (loaded dynamically via preset)
-    sf::Texture texIdle, texRun, texJump;
-    sf::Texture texAttack1, texAttack2, texAttack3, texShield;
-    sf::Texture texHurt, texDead;
+    // Controls for the current tick, filled in by the game before update (keyboard for humans)
+    FighterInput input;
 
-    // Animation frame counts and speeds (set dynamically via preset)
-    int idleFrames, runFrames, jumpFrames;
-    int attack1Frames, attack2Frames, attack3Frames, shieldFrames;
-    int hurtFrames, deadFrames;
-
-    float idleSpeed, runSpeed, jumpSpeed, attackSpeed;
-    float hurtSpeed, deadSpeed;
-
-    // Frame widths (calculated dynamically via preset) and common frame height
-    int idleWidth, runWidth, jumpWidth, attack1Width, attack2Width, attack3Width, shieldWidth, hurtWidth, deadWidth, frameHeight;
+    // Sheets, frame rects and timings for every action (shared per preset, set by loadCharacterAssets)
+    const AnimationTable* animations = nullptr;
+    sf::Color tint = sf::Color::White; // Multiplied into the frame when drawn (the damage flash)
+    int costume = 0;                   // Palette row the frame is drawn with (Costumes in Palette.h)
+    int frameHeight; // Common frame height, from the idle sheet
     float spriteScale; // Sprite scaling factor (set dynamically via preset)
     float groundY; // Y-coordinate of the ground level
 
@@ -109,81 +457,74 @@ public:
         name = preset.name;
         spriteScale = preset.spriteScale;
 
-        bool loaded = true;
-        loaded &= ResourceManager::loadTexture(texIdle, preset.idlePath);
-        loaded &= ResourceManager::loadTexture(texRun, preset.runPath);
-        loaded &= ResourceManager::loadTexture(texJump, preset.jumpPath);
-        loaded &= ResourceManager::loadTexture(texAttack1, preset.attack1Path);
-        loaded &= ResourceManager::loadTexture(texAttack2, preset.attack2Path);
-        loaded &= ResourceManager::loadTexture(texAttack3, preset.attack3Path);
-        loaded &= ResourceManager::loadTexture(texShield, preset.shieldPath);
-        loaded &= ResourceManager::loadTexture(texHurt, preset.hurtPath);
-        loaded &= ResourceManager::loadTexture(texDead, preset.deadPath);
-
-        if (!loaded) { 
-            std::cerr << "CRITICAL: Failed to load one or more " << preset.name << " character textures." << std::endl; 
-        }
-
-        // Set frame counts and speeds from preset
-        idleFrames = preset.idleFrames;
-        runFrames = preset.runFrames;
-        jumpFrames = preset.jumpFrames;
-        attack1Frames = preset.attack1Frames;
-        attack2Frames = preset.attack2Frames;
-        attack3Frames = preset.attack3Frames;
-        shieldFrames = preset.shieldFrames;
-        hurtFrames = preset.hurtFrames;
-        deadFrames = preset.deadFrames;
-
-        idleSpeed = preset.idleSpeed;
-        runSpeed = preset.runSpeed;
-        jumpSpeed = preset.jumpSpeed;
-        attackSpeed = preset.attackSpeed;
-        hurtSpeed = preset.hurtSpeed;
-        deadSpeed = preset.deadSpeed;
-
-        // Calculate frame widths based on loaded textures and frame counts
-        if (texIdle.getSize().y > 0) frameHeight = texIdle.getSize().y; else frameHeight = 100; 
-
-        idleWidth = texIdle.getSize().x > 0 ? texIdle.getSize().x / idleFrames : 100;
-        runWidth = texRun.getSize().x > 0 ? texRun.getSize().x / runFrames : 100;
-        jumpWidth = texJump.getSize().x > 0 ? texJump.getSize().x / jumpFrames : 100;
-        attack1Width = texAttack1.getSize().x > 0 ? texAttack1.getSize().x / attack1Frames : 100;
-        attack2Width = texAttack2.getSize().x > 0 ? texAttack2.getSize().x / attack2Frames : 100;
-        attack3Width = texAttack3.getSize().x > 0 ? texAttack3.getSize().x / attack3Frames : 100;
-        shieldWidth = texShield.getSize().x > 0 ? texShield.getSize().x / shieldFrames : 100;
-        hurtWidth = texHurt.getSize().x > 0 ? texHurt.getSize().x / hurtFrames : 100;
-        deadWidth = texDead.getSize().x > 0 ? texDead.getSize().x / deadFrames : 100;
+        animations = &AnimationTable::load(type);
+        frameHeight = animations->frameHeight;
 
         setupSprite(); 
     }
 
     void setupSprite() {
-        sprite.setTexture(texIdle);
-        sprite.setTextureRect(sf::IntRect(0, 0, idleWidth, frameHeight));
-        sprite.setScale(spriteScale, spriteScale);
+        showFrame(Action::IDLE, 0);
     }
 
     void resetPosition(float xPos) {
-        sprite.setPosition(xPos, groundY);
+        setPosition(xPos, groundY);
+    }
+
+    // --- Placement ---
+    // The fighter is drawn as its current frame's prebuilt quad at `position`; bounds are that
+    // frame's cell (untrimmed) at that position. Both change only through these, so the bounds are worked out
+    // when the position or frame changes rather than each time someone asks.
+    const sf::Vector2f& getPosition() const { return position; }
+    const sf::FloatRect& getBounds() const { return bounds; }
+    const sf::Texture* shownTexture() const { return clip(shownAction).texture; }
+    // The palette the shown texture's indices refer to; nullptr when the atlas holds plain colours
+    const sf::Texture* paletteTexture() const { return animations->indexed ? &animations->palette : nullptr; }
+    Action getShownAction() const { return shownAction; }
+    int getShownFrame() const { return shownFrame; }
+
+    void setPosition(float x, float y) {
+        position = sf::Vector2f(x, y);
+        bounds.left = x;
+        bounds.top = y;
+    }
+
+    void move(float dx, float dy) { setPosition(position.x + dx, position.y + dy); }
+
+    // Puts a frame on screen (and its size into the bounds)
+    void showFrame(Action action, int frame) {
+        shownAction = action;
+        shownFrame = frame;
+        const sf::IntRect& cell = clip(action).frames[frame];
+        bounds = sf::FloatRect(position.x, position.y, cell.width * spriteScale, cell.height * spriteScale);
+    }
+
+    // The current frame's quad for the current facing, tinted, ready to draw at getPosition()
+    void frameQuad(sf::Vertex (&out)[4]) const {
+        const sf::Vertex* quad = clip(shownAction).quads[shownFrame][facingRight ? 1 : 0];
+        for (int i = 0; i < 4; ++i) {
+            out[i] = quad[i];
+            out[i].color = tint;
+        }
     }
 
 
     void setGroundY(float newGroundY) {
         groundY = newGroundY;
         if (!isJumping && isAlive) {
-            sprite.setPosition(sprite.getPosition().x, groundY);
+            setPosition(position.x, groundY);
         }
     }
 
     virtual void update(float dt, float windowWidth, Character* opponent = nullptr) {
+        TRACE_SCOPE("Character::update");
         previousAction = currentAction;
 
         if (!isAlive) {
             currentAction = Action::DEAD;
         } else if (isHurt) {
             currentAction = Action::HURT;
-            if (hurtClock.getElapsedTime().asSeconds() >= hurtSpeed * hurtFrames) {
+            if (hurtClock.getElapsedTime().asSeconds() >= clip(Action::HURT).length) {
                 isHurt = false;
                 currentAction = Action::IDLE;
             }
@@ -192,7 +533,7 @@ public:
         if (isDamageFlashing) {
             if (damageFlashTimer.getElapsedTime().asSeconds() >= GameConfig::DAMAGE_FLASH_DURATION) {
                 isDamageFlashing = false;
-                sprite.setColor(sf::Color::White); 
+                tint = sf::Color::White;
             }
         }
 
@@ -203,10 +544,10 @@ public:
 
             if (isJumping) {
                 verticalVelocity += GameConfig::GRAVITY * dt * 60.f; 
-                sprite.move(0, verticalVelocity * dt * 60.f); 
+                move(0, verticalVelocity * dt * 60.f);
 
-                if (sprite.getPosition().y >= groundY) { 
-                    sprite.setPosition(sprite.getPosition().x, groundY);
+                if (position.y >= groundY) {
+                    setPosition(position.x, groundY);
                     isJumping = false;
                     verticalVelocity = 0;
                     if (!isAttacking && !isShielding && currentAction == Action::JUMP) {
@@ -223,105 +564,61 @@ public:
             animTime = 0.0f;
         }
 
-        sf::FloatRect bounds = sprite.getGlobalBounds();
-        if (bounds.left < 0) sprite.setPosition(0, sprite.getPosition().y);
+        if (bounds.left < 0) setPosition(0, position.y);
         if (bounds.left + bounds.width > windowWidth) {
-            sprite.setPosition(windowWidth - bounds.width, sprite.getPosition().y);
+            setPosition(windowWidth - bounds.width, position.y);
         }
 
-        updateAnimationFrame(dt); 
-
-        sprite.setScale(facingRight ? spriteScale : -spriteScale, spriteScale);
-        if (sprite.getTexture()) { 
-             sf::FloatRect localBounds = sprite.getLocalBounds();
-             sprite.setOrigin(facingRight ? 0 : localBounds.width, 0);
-        }
+        updateAnimationFrame(dt); // Facing needs nothing here: frameQuad picks the mirrored quad when drawn
     }
 
     virtual void handleInput() { /* Player specific input handling */ }
 
+    const AnimationClip& clip(Action action) const { return animations->clips[static_cast<int>(action)]; }
+
+    // Animation length in frames for an action, from the loaded preset
+    int frameCount(Action action) const { return clip(action).frameCount; }
+
+    // Moves the current clip on by `dt`, keeping whatever time is left over when a frame ends so
+    // the animation runs at the preset's speed whatever the tick length. FighterSim::advanceAnimation
+    // is the texture-free twin of this; change both together.
     virtual void updateAnimationFrame(float dt) {
-        float speed = 0.f;
-        int maxFrames = 0;
-        int currentTextureWidth = 0;
-        sf::Texture* currentTexture = nullptr;
-
-        Action actionToAnimate = currentAction;
-
-        // Use character-specific frame counts and speeds based on current loaded preset
-        switch (actionToAnimate) {
-            case Action::IDLE:
-                speed = idleSpeed; maxFrames = idleFrames;
-                currentTexture = &texIdle; currentTextureWidth = idleWidth;
-                break;
-            case Action::RUN:
-                speed = runSpeed; maxFrames = runFrames;
-                currentTexture = &texRun; currentTextureWidth = runWidth;
-                break;
-            case Action::JUMP:
-                speed = jumpSpeed; maxFrames = jumpFrames;
-                currentTexture = &texJump; currentTextureWidth = jumpWidth;
-                break;
-            case Action::ATTACK1:
-                speed = attackSpeed; maxFrames = attack1Frames;
-                currentTexture = &texAttack1; currentTextureWidth = attack1Width;
-                break;
-            case Action::ATTACK2:
-                speed = attackSpeed; maxFrames = attack2Frames;
-                currentTexture = &texAttack2; currentTextureWidth = attack2Width;
-                break;
-            case Action::ATTACK3:
-                speed = attackSpeed; maxFrames = attack3Frames;
-                currentTexture = &texAttack3; currentTextureWidth = attack3Width;
-                break;
-            case Action::SHIELD:
-                speed = idleSpeed; maxFrames = shieldFrames; 
-                currentTexture = &texShield; currentTextureWidth = shieldWidth;
-                break;
-            case Action::HURT:
-                speed = hurtSpeed; maxFrames = hurtFrames;
-                currentTexture = &texHurt; currentTextureWidth = hurtWidth;
-                break;
-            case Action::DEAD:
-                speed = deadSpeed; maxFrames = deadFrames;
-                currentTexture = &texDead; currentTextureWidth = deadWidth;
-                break;
+        const AnimationClip* current = &clip(currentAction);
+        animTime += dt;
+        if (currentFrame >= current->frameCount) finishClip(*current); // The action changed under a later frame
+        while (current->frameCount > 0 && animTime >= current->durations[currentFrame]) {
+            animTime -= current->durations[currentFrame];
+            if (++currentFrame < current->frameCount) continue;
+            if (!finishClip(*current)) break;
+            current = &clip(currentAction);
         }
 
-        animTime += dt;
-        if (animTime >= speed && maxFrames > 0) { 
-            animTime = 0;
-            currentFrame++;
+        if (current->frameCount > 0) showFrame(currentAction, currentFrame);
+    }
 
-            if (actionToAnimate == Action::DEAD) {
-                if (currentFrame >= maxFrames) {
-                     currentFrame = maxFrames -1;
-                }
-            } else if (actionToAnimate == Action::HURT) {
-                if (currentFrame >= maxFrames) {
-                    currentFrame = maxFrames - 1; 
-                }
-            } else if (isAttacking && (currentAction == Action::ATTACK1 || currentAction == Action::ATTACK2 || currentAction == Action::ATTACK3)) {
-                if (currentFrame >= maxFrames) {
-                    isAttacking = false; 
-                    if (!isHurt && isAlive) {
-                        currentAction = Action::IDLE; 
-                        currentFrame = 0;
-                    }
-                }
-            } else if (currentFrame >= maxFrames) {
-                currentFrame = 0; 
-                if (actionToAnimate == Action::JUMP && isJumping) { 
-                    currentFrame = std::min(currentFrame, maxFrames -1); 
+    // Past the last frame: apply the clip's end rule. Returns false when the animation stops here.
+    bool finishClip(const AnimationClip& ended) {
+        switch (ended.end) {
+            case AnimationEnd::LOOP:
+                currentFrame = 0;
+                return true;
+            case AnimationEnd::HOLD:
+                currentFrame = std::max(ended.frameCount - 1, 0);
+                animTime = 0.f;
+                return false;
+            case AnimationEnd::NEXT:
+                if (!isAttacking) { // Not a live swing (cancelled by a hit): just replay it
+                    currentFrame = 0;
+                    return true;
                 }
-            }
-        }
-
-        if (currentTexture && currentTexture->getSize().x > 0 && currentTextureWidth > 0) {
-            sprite.setTexture(*currentTexture);
-            sprite.setTextureRect(sf::IntRect(currentFrame * currentTextureWidth, 0,
-                                            currentTextureWidth, frameHeight));
+                isAttacking = false;
+                currentFrame = 0;
+                if (isHurt || !isAlive) return true;
+                currentAction = static_cast<Action>(ended.next);
+                animTime = 0.f; // The next action starts fresh, as a change of action always has
+                return false;
         }
+        return false;
     }
 
     virtual void takeDamage(float damage) {
@@ -333,7 +630,7 @@ public:
 
         isDamageFlashing = true;
         damageFlashTimer.restart();
-        sprite.setColor(sf::Color(255, 100, 100, 220)); 
+        tint = sf::Color(255, 100, 100, 220);
 
         isAttacking = false; 
 
@@ -347,8 +644,12 @@ public:
     // Calculates the bounding box for the character's attack
     sf::FloatRect getAttackHitbox() const {
         if (!isAttacking) return sf::FloatRect(); 
+        return attackHitboxFacing(facingRight);
+    }
 
-        sf::FloatRect spriteBounds = sprite.getGlobalBounds();
+    // Where a swing would land if one started now facing the given way (used by the AI to judge reach)
+    sf::FloatRect attackHitboxFacing(bool right) const {
+        const sf::FloatRect& spriteBounds = bounds;
         float hitboxWidth = 70.f;
         float hitboxHeight = spriteBounds.height * 0.7f; 
         float hitboxY = spriteBounds.top + spriteBounds.height * 0.15f; 
@@ -357,7 +658,7 @@ public:
         float forwardProjection = spriteBounds.width * 0.3f; 
 
         float hitboxX;
-        if (facingRight) {
+        if (right) {
             hitboxX = spriteBounds.left + spriteBounds.width - forwardProjection + reachOffset;
         } else {
             hitboxX = spriteBounds.left + forwardProjection - hitboxWidth - reachOffset;
@@ -365,30 +666,22 @@ public:
         return sf::FloatRect(hitboxX, hitboxY, hitboxWidth, hitboxHeight);
     }
 
-    // Calculates the character's "hurtbox" (collidable body area)
+    // Calculates the character's "hurtbox" (collidable body area): the shown frame's measured
+    // body (see AnimationTable::measureFrame) for the current facing
     sf::FloatRect getHurtbox() const {
-        float widthRatio = 0.35f; 
-        float heightRatio = 0.8f; 
-
-        float xOffsetRatio = (1.0f - widthRatio) / 2.0f;
-        float yOffsetRatio = 0.1f; 
-
-        sf::FloatRect globalBounds = sprite.getGlobalBounds();
-
-        float actualWidth = globalBounds.width * widthRatio;
-        float actualHeight = globalBounds.height * heightRatio;
-
-        float xPos, yPos;
-
-        yPos = globalBounds.top + globalBounds.height * yOffsetRatio;
+        const sf::FloatRect& body = clip(shownAction).hurtboxes[shownFrame][facingRight ? 1 : 0];
+        return sf::FloatRect(position.x + body.left, position.y + body.top, body.width, body.height);
+    }
 
-        if (facingRight) {
-            xPos = globalBounds.left + globalBounds.width * xOffsetRatio;
-        } else {
-            xPos = globalBounds.left + globalBounds.width - (globalBounds.width * xOffsetRatio) - actualWidth;
-        }
+    // The shown frame's opaque pixels for the current facing, placed at pixelPosition()
+    const FrameMask& getMask() const { return clip(shownAction).masks[shownFrame][facingRight ? 1 : 0]; }
+    sf::Vector2i pixelPosition() const {
+        return sf::Vector2i(static_cast<int>(std::lround(position.x)), static_cast<int>(std::lround(position.y)));
+    }
 
-        return sf::FloatRect(xPos, yPos, actualWidth, actualHeight);
+    // Pixel-precise check behind an AABB hit: do the two fighters' drawn pixels touch inside `area`?
+    bool pixelsOverlap(const Character& other, const sf::FloatRect& area) const {
+        return FrameMask::overlap(getMask(), pixelPosition(), other.getMask(), other.pixelPosition(), FrameMask::covering(area));
     }
 
 
@@ -402,7 +695,7 @@ public:
         isAlive = true;
         dealtDamageThisAttack = false;
         isDamageFlashing = false;
-        sprite.setColor(sf::Color::White);
+        tint = sf::Color::White;
         verticalVelocity = 0;
         currentFrame = 0;
         animTime = 0;
@@ -414,15 +707,28 @@ public:
         setupSprite(); 
     }
 
-    virtual void draw(sf::RenderWindow& window) const {
-        window.draw(sprite);
+    virtual void draw(sf::RenderTarget& window) const {
+        sf::Vertex quad[4];
+        frameQuad(quad);
+        sf::RenderStates states(clip(shownAction).texture);
+        if (const sf::Texture* colors = paletteTexture()) states.shader = PaletteShader::prepare(*colors, costume);
+        states.transform.translate(position);
+        RenderStats::draw(window, quad, 4, sf::Quads, states);
     }
     virtual ~Character() {
         // Destructor
         // No dynamic memory allocation, so nothing to clean up here.
     }
+
+private:
+    sf::Vector2f position;                     // Top-left of the frame on screen, whichever way it faces
+    sf::FloatRect bounds;                      // Screen rect of the frame at `position`
+    Action shownAction = Action::IDLE;         // Frame on screen, set by updateAnimationFrame
+    int shownFrame = 0;
 };
 
+static_assert(ACTION_COUNT == static_cast<int>(Character::Action::DEAD) + 1, "One animation per Character::Action");
+
 // --- Player Class ---
 class Player : public Character {
 public:
@@ -434,6 +740,7 @@ public:
     }
 
     void update(float dt, float windowWidth, Character* opponent = nullptr) override {
+        TRACE_SCOPE("Player::update");
         if (!isAlive || isHurt) { 
              Character::update(dt, windowWidth, opponent);
              return;
@@ -442,20 +749,20 @@ public:
         bool isMoving = false;
 
         if (!isAttacking && !isShielding) { 
-            float moveSpeed = GameConfig::MOVEMENT_SPEED * (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ?
+            float moveSpeed = GameConfig::MOVEMENT_SPEED * (input.has(FighterInput::RUN) ?
                              GameConfig::RUN_BOOST_MULTIPLIER : 1.f) * dt * 60.f;
 
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-                sprite.move(-moveSpeed, 0);
+            if (input.has(FighterInput::LEFT)) {
+                move(-moveSpeed, 0);
                 isMoving = true;
                 facingRight = false;
             }
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-                sprite.move(moveSpeed, 0);
+            if (input.has(FighterInput::RIGHT)) {
+                move(moveSpeed, 0);
                 isMoving = true;
                 facingRight = true;
             }
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) && !isJumping) {
+            if (input.has(FighterInput::JUMP) && !isJumping) {
                 isJumping = true;
                 verticalVelocity = GameConfig::JUMP_STRENGTH; 
             }
@@ -476,7 +783,7 @@ public:
     void handleInput() override {
         if (!isAlive || isHurt) return; 
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::T)) {
+        if (input.has(FighterInput::SHIELD)) {
             if (!isAttacking) {
                 isShielding = true;
                 currentAction = Action::SHIELD;
@@ -487,9 +794,9 @@ public:
 
         if (!isShielding && canAttack && !isAttacking) {
             Action attackAttempt = Action::IDLE;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::F)) attackAttempt = Action::ATTACK1;
-            else if (sf::Keyboard::isKeyPressed(sf::Keyboard::G)) attackAttempt = Action::ATTACK2;
-            else if (sf::Keyboard::isKeyPressed(sf::Keyboard::H)) attackAttempt = Action::ATTACK3;
+            if (input.has(FighterInput::ATTACK1)) attackAttempt = Action::ATTACK1;
+            else if (input.has(FighterInput::ATTACK2)) attackAttempt = Action::ATTACK2;
+            else if (input.has(FighterInput::ATTACK3)) attackAttempt = Action::ATTACK3;
 
             if (attackAttempt != Action::IDLE) { 
                 isAttacking = true;
@@ -515,27 +822,20 @@ public:
 
 class Enemy : public Character {
 public:
-    bool isPlayerControlled = false;
-
-    float detectionRange = 450.0f;
-    float optimalAttackRangeMin = GameConfig::ATTACK_RANGE * 0.3f; 
-    float optimalAttackRangeMax = GameConfig::ATTACK_RANGE * 0.7f; 
-    sf::Clock aiDecisionClock;
-    float aiDecisionInterval = 0.15f; 
-    bool isActivelyChasing = false; 
+    bool isPlayerControlled = false; // Otherwise Game's FighterAI fills `input` each tick (see FighterAI.h)
 
     Enemy() : Character() {
         // Default to Rogue initially. Actual character loading happens in Game::handleScreenTransition.
         loadCharacterAssets(CharacterTypeID::ROGUE);
         name = "Rival"; 
         facingRight = false; 
-        sprite.setScale(spriteScale, spriteScale); 
     }
 
+    // Shield and attack buttons from `input` (player 2 or the AI); movement happens in update
     void handlePlayer2Input() {
         if (!isAlive || isHurt) return; 
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad0)) { 
+        if (input.has(FighterInput::SHIELD)) { 
             if (!isAttacking) {
                 isShielding = true;
                 currentAction = Action::SHIELD;
@@ -546,9 +846,9 @@ public:
 
         if (!isShielding && canAttack && !isAttacking) { 
             Action attackAttempt = Action::IDLE;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad1)) attackAttempt = Action::ATTACK1; 
-            else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad2)) attackAttempt = Action::ATTACK2; 
-            else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad3)) attackAttempt = Action::ATTACK3; 
+            if (input.has(FighterInput::ATTACK1)) attackAttempt = Action::ATTACK1; 
+            else if (input.has(FighterInput::ATTACK2)) attackAttempt = Action::ATTACK2; 
+            else if (input.has(FighterInput::ATTACK3)) attackAttempt = Action::ATTACK3; 
 
             if (attackAttempt != Action::IDLE) {
                 isAttacking = true;
@@ -564,90 +864,44 @@ public:
 
 
     void update(float dt, float windowWidth, Character* playerPtr) override {
+        TRACE_SCOPE("Enemy::update");
         if (!isAlive || isHurt) { 
              Character::update(dt, windowWidth, playerPtr);
              return;
         }
 
-        if (isPlayerControlled) {
-            bool isMoving = false;
-            if (!isAttacking && !isShielding) { 
-                float moveSpeed = GameConfig::MOVEMENT_SPEED * (sf::Keyboard::isKeyPressed(sf::Keyboard::RShift) ?
-                                 GameConfig::RUN_BOOST_MULTIPLIER : 1.f) * dt * 60.f;
+        // Player 2's keys or the AI, both arrive as `input`
+        bool isMoving = false;
+        if (!isAttacking && !isShielding) { 
+            float moveSpeed = GameConfig::MOVEMENT_SPEED * (input.has(FighterInput::RUN) ?
+                             GameConfig::RUN_BOOST_MULTIPLIER : 1.f) * dt * 60.f;
 
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-                    sprite.move(-moveSpeed, 0); isMoving = true; facingRight = false;
-                }
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-                    sprite.move(moveSpeed, 0); isMoving = true; facingRight = true;
-                }
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) && !isJumping) {
-                    isJumping = true; verticalVelocity = GameConfig::JUMP_STRENGTH;
-                }
+            if (input.has(FighterInput::LEFT)) {
+                move(-moveSpeed, 0); isMoving = true; facingRight = false;
             }
-
-            if (!isAttacking && !isShielding) {
-                if (isJumping) currentAction = Action::JUMP;
-                else if (isMoving) currentAction = Action::RUN;
-                else currentAction = Action::IDLE;
-            } else if (isShielding) {
-                currentAction = Action::SHIELD;
+            if (input.has(FighterInput::RIGHT)) {
+                move(moveSpeed, 0); isMoving = true; facingRight = true;
             }
-
-        } else { // AI Logic
-            if (playerPtr && playerPtr->isAlive) { 
-                if (aiDecisionClock.getElapsedTime().asSeconds() > aiDecisionInterval) {
-                    aiDecisionClock.restart();
-                    float distToPlayer = Utils::distance(sprite.getPosition(), playerPtr->sprite.getPosition());
-
-                    if (!isAttacking && !isShielding) { 
-                        if (distToPlayer <= optimalAttackRangeMax && distToPlayer >= optimalAttackRangeMin && canAttack) {
-                            isAttacking = true;
-                            dealtDamageThisAttack = false;
-                            canAttack = false;
-                            currentAction = Action::ATTACK1; 
-                            isActivelyChasing = false; 
-                        } else if (distToPlayer < detectionRange) {
-                            isActivelyChasing = true;
-                        } else {
-                            isActivelyChasing = false;
-                        }
-                    }
-                }
-
-                if (isAttacking) {
-                } else if (isActivelyChasing && !isShielding) { 
-                    currentAction = Action::RUN;
-                    float moveSpeed = GameConfig::MOVEMENT_SPEED * 0.7f * dt * 60.f; 
-
-                    if (playerPtr->sprite.getPosition().x < sprite.getPosition().x - optimalAttackRangeMin * 0.5f) {
-                        sprite.move(-moveSpeed, 0);
-                        facingRight = false;
-                    } else if (playerPtr->sprite.getPosition().x > sprite.getPosition().x + optimalAttackRangeMin * 0.5f) {
-                        sprite.move(moveSpeed, 0);
-                        facingRight = true;
-                    } else {
-                    }
-                    if (playerPtr->sprite.getPosition().x < sprite.getPosition().x && facingRight) facingRight = false;
-                    else if (playerPtr->sprite.getPosition().x > sprite.getPosition().x && !facingRight) facingRight = true;
-
-                } else if (!isShielding) { 
-                    currentAction = Action::IDLE;
-                }
-            } else { 
-                isActivelyChasing = false;
-                if (!isAttacking && !isShielding) currentAction = Action::IDLE;
+            if (input.has(FighterInput::JUMP) && !isJumping) {
+                isJumping = true; verticalVelocity = GameConfig::JUMP_STRENGTH;
             }
         }
+
+        if (!isAttacking && !isShielding) {
+            if (isJumping) currentAction = Action::JUMP;
+            else if (isMoving) currentAction = Action::RUN;
+            else currentAction = Action::IDLE;
+        } else if (isShielding) {
+            currentAction = Action::SHIELD;
+        }
         Character::update(dt, windowWidth, playerPtr); 
     }
 
     // Enemy::reset(float xPos) override -> Corrected to match Character::reset() signature
     void reset() override {
         Character::reset(); // Call base class reset
-        // The xPos will be set by Game::handleScreenTransition directly on the sprite
+        // The xPos will be set by Game::handleScreenTransition through resetPosition
         // after calling this reset, so no xPos param here.
-        isActivelyChasing = false;
         // Ensure sprite texture is set back to Idle after reset
         setupSprite(); // Call setupSprite to apply texIdle and rect
     }
@@ -1,34 +1,36 @@
 #pragma once
-#include <string>
+#include <cstring>
 #include <SFML/Graphics.hpp>
 #include "Utils.h"
 #include "GameConfig.h"
+#include "SimClock.h"
 
 // --- Damage Text Struct ---
+// Plain data only: the label is a short fixed buffer and the HUD lays it out through its glyph
+// atlas, so spawning and animating damage numbers does not touch the heap or rebuild sf::Text.
 struct DamageText {
-    sf::Text text;
+    char label[8];
+    sf::Vector2f position; // Center of the label
+    sf::Vector2f previousPosition; // Position before the last tick, for interpolated drawing
+    sf::Color color;
     sf::Vector2f velocity;
     float lifetime;
-    sf::Clock clock;
+    SimClock clock;
 
-    DamageText(const std::string& str, sf::Font& font, unsigned int charSize, sf::Color color, sf::Vector2f startPos) {
-        text.setFont(font);
-        text.setString(str);
-        text.setCharacterSize(charSize);
-        text.setFillColor(color);
-        Utils::centerOrigin(text);
-        text.setPosition(startPos);
+    DamageText(const char* str, sf::Color textColor, sf::Vector2f startPos)
+        : position(startPos), previousPosition(startPos), color(textColor) {
+        std::strncpy(label, str, sizeof(label) - 1);
+        label[sizeof(label) - 1] = '\0';
 
         velocity = sf::Vector2f(Utils::randomFloat(-10.f, 10.f), GameConfig::DAMAGE_TEXT_SPEED + Utils::randomFloat(-10.f, 10.f));
         lifetime = GameConfig::DAMAGE_TEXT_LIFETIME;
     }
 
     void update(float dt) {
-        text.move(velocity * dt);
+        previousPosition = position;
+        position += velocity * dt;
         float t = clock.getElapsedTime().asSeconds() / lifetime;
-        sf::Color color = text.getFillColor();
         color.a = static_cast<sf::Uint8>(Utils::lerp(255.f, 0.f, t));
-        text.setFillColor(color);
     }
 
     bool isExpired() const {
@@ -0,0 +1,281 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include "Character.h"
+#include "GameConfig.h"
+#include "Input.h"
+#include "Trace.h"
+
+// --- Fighter AI ---
+// Computer opponents play through the same FighterInput a second player's keyboard fills in, so
+// anything that can hold a controller (this utility AI, a replay, a script) can drive a fighter
+// without the fighter knowing the difference. The game calls decide() once per live match tick
+// on the simulation thread, with simMutex held.
+class FighterAI {
+public:
+    virtual ~FighterAI() = default;
+
+    // Fill `out` with this tick's controls for `self`
+    virtual void decide(const Character& self, const Character& opponent, FighterInput& out) = 0;
+
+    // New match: drop anything remembered from the last one
+    virtual void reset() {}
+};
+
+enum class AIDifficulty { EASY, NORMAL, HARD, TABLE, EXPERT, SHADOW, BOT };
+
+// How an AI plays. Scores are weighted by these, so profiles differ in style as well as speed.
+struct AIProfile {
+    const char* name;
+    int reactionTicks;  // Ticks between decisions; the chosen option is held in between
+    float aggression;   // Pull towards closing in and swinging
+    float caution;      // Pull towards blocking, backing off and jumping clear when threatened
+    float blockSkill;   // How reliably an incoming swing is read (0-1)
+    float noise;        // Random jitter added to every score; higher plays sloppier
+};
+
+const AIProfile& aiProfile(AIDifficulty difficulty) {
+    static const AIProfile profiles[] = {
+        {"Easy",   18, 0.7f, 0.4f, 0.25f, 0.45f},
+        {"Normal",  9, 1.0f, 0.8f, 0.55f, 0.20f},
+        {"Hard",    4, 1.2f, 1.0f, 0.85f, 0.05f},
+        {"Table",   4, 1.0f, 1.0f, 0.00f, 0.00f}, // Plays from a compiled policy table (PolicyTable.h); only reactionTicks applies
+        {"Expert",  6, 1.2f, 1.0f, 0.90f, 0.00f}, // Plays by look-ahead search (SearchAI.h); only reactionTicks applies
+        {"Shadow",  1, 1.0f, 1.0f, 0.00f, 0.00f}, // Plays the player's recorded habits (ShadowAI.h); only reactionTicks applies
+        {"Bot",     1, 1.0f, 1.0f, 0.00f, 0.00f}, // Played by another process over shared memory (BotLink.h); unused
+    };
+    return profiles[static_cast<int>(difficulty)];
+}
+
+// What an AI "sees" in one tick, taken from the live fighters. Distances are between hurtboxes.
+struct AIPerception {
+    float dx = 0.f;               // Opponent's hurtbox centre minus ours; positive means to our right
+    float distance = 0.f;         // |dx|
+    float selfHealth = 1.f;       // Fractions of max health
+    float opponentHealth = 1.f;
+    Character::Action opponentAction = Character::Action::IDLE;
+    float opponentProgress = 0.f; // How far the opponent is through its current animation (0-1)
+    bool inReach = false;         // A swing started now, facing the opponent, would land
+    bool threatened = false;      // The opponent could land a swing on us now or is mid-swing in range
+    bool facingOpponent = false;
+    bool canAttack = false;       // Off cooldown and free to start a swing
+    bool opponentVulnerable = false; // Hurt or recovering from a swing that already connected or missed
+
+    static AIPerception observe(const Character& self, const Character& opponent) {
+        AIPerception p;
+        sf::FloatRect selfBox = self.getHurtbox();
+        sf::FloatRect opponentBox = opponent.getHurtbox();
+        p.dx = (opponentBox.left + opponentBox.width / 2.f) - (selfBox.left + selfBox.width / 2.f);
+        p.distance = std::abs(p.dx);
+        p.selfHealth = self.maxHealth > 0.f ? self.currentHealth / self.maxHealth : 0.f;
+        p.opponentHealth = opponent.maxHealth > 0.f ? opponent.currentHealth / opponent.maxHealth : 0.f;
+        p.opponentAction = opponent.currentAction;
+
+        int frames = opponent.frameCount(opponent.currentAction);
+        p.opponentProgress = frames > 0 ? std::min(1.f, static_cast<float>(opponent.currentFrame) / frames) : 0.f;
+
+        bool opponentToRight = p.dx >= 0.f;
+        p.facingOpponent = self.facingRight == opponentToRight;
+        p.inReach = self.attackHitboxFacing(opponentToRight).intersects(opponentBox);
+
+        bool opponentFacingUs = opponent.facingRight != opponentToRight;
+        bool opponentReaches = opponent.attackHitboxFacing(opponent.facingRight).intersects(selfBox);
+        bool opponentSwingLive = opponent.isAttacking && !opponent.dealtDamageThisAttack;
+        p.threatened = opponent.isAlive && !opponent.isHurt && opponentFacingUs && opponentReaches &&
+                       (opponent.canAttack || opponentSwingLive);
+
+        p.canAttack = self.canAttack && !self.isAttacking && !self.isHurt && self.isAlive;
+        // Committed to a swing that has already connected, or is past its midpoint
+        p.opponentVulnerable = opponent.isHurt ||
+                               (opponent.isAttacking && (opponent.dealtDamageThisAttack || p.opponentProgress >= 0.5f)) ||
+                               (!opponent.canAttack && !opponent.isAttacking);
+        return p;
+    }
+};
+
+// What an AI can choose to do; held over several ticks and turned into buttons by pressOption
+enum class AIOption { IDLE, APPROACH, RETREAT, BLOCK, JUMP, ATTACK1, ATTACK2, ATTACK3, COUNT };
+const int AI_OPTION_COUNT = static_cast<int>(AIOption::COUNT);
+
+// The held option as controller buttons. `dx` is the opponent's offset (positive: to our right).
+// One-shot options (a jump, a swing) fall back to IDLE once pressed.
+void pressOption(AIOption& held, float dx, bool facingOpponent, FighterInput& out) {
+    out = FighterInput();
+    float distance = std::abs(dx);
+    FighterInput::Button toward = dx >= 0.f ? FighterInput::RIGHT : FighterInput::LEFT;
+    FighterInput::Button away = dx >= 0.f ? FighterInput::LEFT : FighterInput::RIGHT;
+
+    switch (held) {
+        case AIOption::IDLE:
+            break;
+        case AIOption::APPROACH:
+            out.set(toward, true);
+            out.set(FighterInput::RUN, distance > 300.f);
+            break;
+        case AIOption::RETREAT:
+            out.set(away, true);
+            break;
+        case AIOption::BLOCK:
+            out.set(FighterInput::SHIELD, true);
+            break;
+        case AIOption::JUMP:
+            out.set(FighterInput::JUMP, true);
+            out.set(away, true);
+            held = AIOption::IDLE; // One press; the jump plays out on its own
+            break;
+        case AIOption::ATTACK1:
+        case AIOption::ATTACK2:
+        case AIOption::ATTACK3:
+            // A swing can't turn the fighter, so face the opponent first (one tick of walking)
+            if (!facingOpponent) {
+                out.set(toward, true);
+            } else {
+                out.set(held == AIOption::ATTACK1 ? FighterInput::ATTACK1 :
+                        held == AIOption::ATTACK2 ? FighterInput::ATTACK2 : FighterInput::ATTACK3, true);
+                held = AIOption::IDLE;
+            }
+            break;
+        case AIOption::COUNT:
+            break;
+    }
+}
+
+// --- AI Budget ---
+// Wall-clock time every AI in the match may spend deciding in one tick. An AI that finds the
+// budget spent keeps its previous choice and decides first thing next tick instead, so a crowd of
+// AI fighters degrades into slightly slower reactions rather than a late tick.
+struct AIBudget {
+    std::int64_t perTickNs = static_cast<std::int64_t>(GameConfig::AI_TICK_BUDGET_US * 1000.f);
+    std::int64_t spentNs = 0;
+
+    // Totals since the budget was created
+    std::uint64_t decisions = 0;
+    std::uint64_t deferred = 0;
+    std::int64_t worstDecisionNs = 0;
+
+    // Look-ahead searches (SearchAI), which run off the simulation thread and aren't charged above
+    std::uint64_t searches = 0;
+    std::uint64_t searchNodes = 0; // Simulated ticks
+    std::int64_t searchNs = 0;
+    std::uint64_t searchDepthSum = 0;
+    std::uint64_t searchesCutShort = 0; // Stopped by the deadline before the deepest pass
+
+    void beginTick() { spentNs = 0; }
+    bool hasTimeLeft() const { return perTickNs <= 0 || spentNs < perTickNs; }
+
+    void charge(std::int64_t ns) {
+        spentNs += ns;
+        ++decisions;
+        worstDecisionNs = std::max(worstDecisionNs, ns);
+    }
+
+    void recordSearch(std::uint64_t nodes, std::int64_t ns, int depth, bool cutShort) {
+        ++searches;
+        searchNodes += nodes;
+        searchNs += ns;
+        searchDepthSum += depth;
+        if (cutShort) ++searchesCutShort;
+    }
+
+    // Simulated ticks per second of search time, per AI (all of its worker threads together)
+    double nodesPerSecond() const { return searchNs > 0 ? searchNodes * 1e9 / searchNs : 0.0; }
+
+    void print(std::ostream& out) const {
+        if (decisions == 0) return;
+        out << "AI: " << decisions << " decisions, worst " << worstDecisionNs / 1000.0 << " us, "
+            << deferred << " deferred by the " << perTickNs / 1000.0 << " us tick budget" << std::endl;
+        if (searches == 0) return;
+        out << "AI search: " << searches << " searches, " << static_cast<long long>(nodesPerSecond()) << " nodes/s, average depth "
+            << static_cast<double>(searchDepthSum) / searches << ", " << searchesCutShort << " cut short by the deadline" << std::endl;
+    }
+};
+
+// --- Utility AI ---
+// Every decision scores each option from the perceived state and the profile, then holds the best
+// one until the next decision. Scores are plain weighted sums kept in [0, ~1.5], so tuning is a
+// matter of reading one function per option.
+class UtilityAI : public FighterAI {
+public:
+    AIProfile profile;
+    AIBudget* budget; // Shared with the other AIs in the match; nullptr means unlimited
+    AIOption current = AIOption::IDLE;
+    float scores[AI_OPTION_COUNT] = {}; // From the last decision, for debugging
+
+    explicit UtilityAI(const AIProfile& aiProfile, AIBudget* sharedBudget = nullptr)
+        : profile(aiProfile), budget(sharedBudget) {}
+
+    void reset() override {
+        current = AIOption::IDLE;
+        ticksUntilDecision = 0;
+        rng.seed(RNG_SEED); // Same match, same choices: keeps replays and benchmarks repeatable
+    }
+
+    void decide(const Character& self, const Character& opponent, FighterInput& out) override {
+        TRACE_SCOPE("UtilityAI::decide");
+        AIPerception p = AIPerception::observe(self, opponent);
+
+        if (--ticksUntilDecision <= 0) {
+            if (!budget || budget->hasTimeLeft()) {
+                auto start = std::chrono::steady_clock::now();
+                current = choose(self, p);
+                ticksUntilDecision = profile.reactionTicks;
+                if (budget) {
+                    budget->charge(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+            } else {
+                ++budget->deferred; // Still due, so this AI goes again next tick
+            }
+        }
+        pressOption(current, p.dx, p.facingOpponent, out);
+    }
+
+private:
+    static const std::uint32_t RNG_SEED = 0x4846u;
+    int ticksUntilDecision = 0;
+    std::minstd_rand rng{RNG_SEED};
+
+    AIOption choose(const Character& self, const AIPerception& p) {
+        if (!self.isAlive || !opponentAlive(p)) return AIOption::IDLE;
+
+        float threat = p.threatened ? 1.f : 0.f;
+        float lowHealth = 1.f - p.selfHealth;
+        float closeness = 1.f - std::min(p.distance / 600.f, 1.f);
+
+        auto score = [&](AIOption option) -> float& { return scores[static_cast<int>(option)]; };
+        score(AIOption::IDLE) = 0.1f;
+        score(AIOption::APPROACH) = p.inReach ? 0.f : profile.aggression * (0.5f + 0.4f * closeness);
+        score(AIOption::RETREAT) = profile.caution * threat * (p.canAttack ? 0.1f : 0.5f + 0.4f * lowHealth);
+        score(AIOption::BLOCK) = profile.caution * threat * profile.blockSkill * (p.canAttack && p.opponentVulnerable ? 0.3f : 1.1f);
+        score(AIOption::JUMP) = profile.caution * threat * (1.f - profile.blockSkill) * 0.6f;
+
+        // All swings hit equally hard the moment they connect, so the shorter the animation the
+        // sooner we are free again; an opponent that can't hit back is worth more
+        const AIOption attacks[] = {AIOption::ATTACK1, AIOption::ATTACK2, AIOption::ATTACK3};
+        const Character::Action actions[] = {Character::Action::ATTACK1, Character::Action::ATTACK2, Character::Action::ATTACK3};
+        for (int i = 0; i < 3; ++i) {
+            float recovery = self.clip(actions[i]).length;
+            float value = p.inReach && p.canAttack ? profile.aggression * (0.9f + (p.opponentVulnerable ? 0.4f : 0.f)) : 0.f;
+            score(attacks[i]) = value * (1.f - std::min(recovery, 1.f) * 0.3f);
+        }
+
+        AIOption best = AIOption::IDLE;
+        float bestScore = -1.f;
+        std::uniform_real_distribution<float> jitter(0.f, profile.noise);
+        for (int i = 0; i < AI_OPTION_COUNT; ++i) {
+            if (scores[i] <= 0.f && i != static_cast<int>(AIOption::IDLE)) continue; // Not applicable right now
+            float value = scores[i] + (profile.noise > 0.f ? jitter(rng) : 0.f);
+            if (value > bestScore) {
+                bestScore = value;
+                best = static_cast<AIOption>(i);
+            }
+        }
+        return best;
+    }
+
+    static bool opponentAlive(const AIPerception& p) { return p.opponentAction != Character::Action::DEAD; }
+};
@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <SFML/Graphics.hpp>
+#include "Character.h"
+#include "GameConfig.h"
+#include "Input.h"
+
+// --- Fighter Sim ---
+// The match rules without sprites or textures: a fighter is a small copyable FighterState, and
+// FighterSim::step advances two of them by one tick exactly the way GamePlayScreen::update moves
+// the live Characters (buttons, movement, physics, animation, hits). Snapshotting is a copy and
+// restoring is an assignment, so search AIs can play thousands of ticks ahead per decision.
+// Keep this in step with Character, Player/Enemy::update and GamePlayScreen::resolveAttack;
+// sim_check.cpp runs both in lockstep and fails on the first tick they disagree.
+
+// The per-character constants the rules read, taken from the loaded preset. Animations are the
+// preset's shared AnimationTable, so copying a model (and a MatchState) stays cheap.
+struct FighterModel {
+    CharacterTypeID type = CharacterTypeID::KNIGHT;
+    const AnimationTable* animations = nullptr;
+    int frameHeight = 0;
+    float scale = 1.f;
+    float groundY = 0.f;
+
+    const AnimationClip& clip(Character::Action action) const { return animations->clips[static_cast<int>(action)]; }
+
+    static FighterModel of(const Character& c) {
+        FighterModel m;
+        m.type = c.charType;
+        m.animations = c.animations;
+        m.frameHeight = c.frameHeight;
+        m.scale = c.spriteScale;
+        m.groundY = c.groundY;
+        return m;
+    }
+
+    // The same constants straight from a preset, for matches that never load Characters: the
+    // table is measured from the sheet sizes, so no window or GL context is needed.
+    static FighterModel fromPreset(CharacterTypeID type) {
+        FighterModel m;
+        m.type = type;
+        m.animations = &AnimationTable::measure(type);
+        m.frameHeight = m.animations->frameHeight;
+        m.scale = AllCharacterPresets.at(type).spriteScale;
+        return m;
+    }
+};
+
+// Everything about a fighter that changes during a match. Timers are stored as elapsed time.
+struct FighterState {
+    float x = 0.f, y = 0.f;      // Sprite position (top-left of the frame, whichever way it faces)
+    float verticalVelocity = 0.f;
+    float health = GameConfig::MAX_HEALTH;
+    float animTime = 0.f;
+    std::int64_t attackCooldownUs = 0; // Microseconds, like SimClock, so thresholds trip on the same tick
+    std::int64_t hurtUs = 0;
+    int frame = 0;
+    Character::Action shownAction = Character::Action::IDLE; // Frame currently on screen (bounds and hurtbox
+    int shownFrame = 0;                                      // lag the action by a tick)
+    Character::Action action = Character::Action::IDLE;
+    bool facingRight = true;
+    bool jumping = false;
+    bool attacking = false;
+    bool shielding = false;
+    bool hurt = false;
+    bool alive = true;
+    bool dealtDamage = false;
+    bool canAttack = true;
+
+    static FighterState capture(const Character& c) {
+        FighterState s;
+        s.x = c.getPosition().x;
+        s.y = c.getPosition().y;
+        s.verticalVelocity = c.verticalVelocity;
+        s.health = c.currentHealth;
+        s.animTime = c.animTime;
+        s.attackCooldownUs = c.attackCooldownClock.getElapsedTime().asMicroseconds();
+        s.hurtUs = c.hurtClock.getElapsedTime().asMicroseconds();
+        s.frame = c.currentFrame;
+        s.shownAction = c.getShownAction();
+        s.shownFrame = c.getShownFrame();
+        s.action = c.currentAction;
+        s.facingRight = c.facingRight;
+        s.jumping = c.isJumping;
+        s.attacking = c.isAttacking;
+        s.shielding = c.isShielding;
+        s.hurt = c.isHurt;
+        s.alive = c.isAlive;
+        s.dealtDamage = c.dealtDamageThisAttack;
+        s.canAttack = c.canAttack;
+        return s;
+    }
+
+    // A fighter as Character::reset and resetPosition leave it at the start of a match
+    // (Player starts facing right, Enemy's constructor turns it left)
+    static FighterState spawn(const FighterModel& m, float xPos, bool faceRight) {
+        FighterState s;
+        s.x = xPos;
+        s.facingRight = faceRight;
+        s.y = m.groundY;
+        return s;
+    }
+
+    sf::FloatRect bounds(const FighterModel& m) const {
+        return sf::FloatRect(x, y, m.clip(shownAction).frames[shownFrame].width * m.scale, m.frameHeight * m.scale);
+    }
+
+    // Character::getHurtbox: the shown frame's measured body
+    sf::FloatRect hurtbox(const FighterModel& m) const {
+        const sf::FloatRect& body = m.clip(shownAction).hurtboxes[shownFrame][facingRight ? 1 : 0];
+        return sf::FloatRect(x + body.left, y + body.top, body.width, body.height);
+    }
+
+    // Character::getMask / pixelPosition
+    const FrameMask& mask(const FighterModel& m) const { return m.clip(shownAction).masks[shownFrame][facingRight ? 1 : 0]; }
+    sf::Vector2i pixelPosition() const { return sf::Vector2i(static_cast<int>(std::lround(x)), static_cast<int>(std::lround(y))); }
+
+    // Same proportions as Character::attackHitboxFacing
+    sf::FloatRect attackHitbox(const FighterModel& m, bool right) const {
+        sf::FloatRect b = bounds(m);
+        float hitboxWidth = 70.f;
+        float forwardProjection = b.width * 0.3f;
+        float left = right ? b.left + b.width - forwardProjection + 10.f : b.left + forwardProjection - hitboxWidth - 10.f;
+        return sf::FloatRect(left, b.top + b.height * 0.15f, hitboxWidth, b.height * 0.7f);
+    }
+};
+
+struct MatchState {
+    FighterState fighters[2]; // [0] player, [1] enemy: the order GamePlayScreen updates them in
+    FighterModel models[2];
+    bool pixelPreciseHits = false; // GameConfig::PIXEL_PRECISE_HITS when captured from a live match
+};
+
+namespace FighterSim {
+    inline int index(Character::Action action) { return static_cast<int>(action); }
+
+    // Player::handleInput / Enemy::handlePlayer2Input
+    void applyButtons(FighterState& s, FighterInput input) {
+        if (!s.alive || s.hurt) return;
+
+        if (input.has(FighterInput::SHIELD)) {
+            if (!s.attacking) {
+                s.shielding = true;
+                s.action = Character::Action::SHIELD;
+            }
+        } else if (s.shielding) {
+            s.shielding = false;
+        }
+
+        if (!s.shielding && s.canAttack && !s.attacking) {
+            Character::Action attack = Character::Action::IDLE;
+            if (input.has(FighterInput::ATTACK1)) attack = Character::Action::ATTACK1;
+            else if (input.has(FighterInput::ATTACK2)) attack = Character::Action::ATTACK2;
+            else if (input.has(FighterInput::ATTACK3)) attack = Character::Action::ATTACK3;
+
+            if (attack != Character::Action::IDLE) {
+                s.attacking = true;
+                s.dealtDamage = false;
+                s.canAttack = false;
+                s.action = attack;
+                s.frame = 0;
+                s.animTime = 0.f;
+                s.attackCooldownUs = 0;
+            }
+        }
+    }
+
+    // Character::finishClip
+    bool finishClip(FighterState& s, const AnimationClip& ended) {
+        switch (ended.end) {
+            case AnimationEnd::LOOP:
+                s.frame = 0;
+                return true;
+            case AnimationEnd::HOLD:
+                s.frame = std::max(ended.frameCount - 1, 0);
+                s.animTime = 0.f;
+                return false;
+            case AnimationEnd::NEXT:
+                if (!s.attacking) {
+                    s.frame = 0;
+                    return true;
+                }
+                s.attacking = false;
+                s.frame = 0;
+                if (s.hurt || !s.alive) return true;
+                s.action = static_cast<Character::Action>(ended.next);
+                s.animTime = 0.f;
+                return false;
+        }
+        return false;
+    }
+
+    // Character::updateAnimationFrame
+    void advanceAnimation(FighterState& s, const FighterModel& m, float dt) {
+        const AnimationClip* current = &m.clip(s.action);
+        s.animTime += dt;
+        if (s.frame >= current->frameCount) finishClip(s, *current);
+        while (current->frameCount > 0 && s.animTime >= current->durations[s.frame]) {
+            s.animTime -= current->durations[s.frame];
+            if (++s.frame < current->frameCount) continue;
+            if (!finishClip(s, *current)) break;
+            current = &m.clip(s.action);
+        }
+        if (current->frameCount > 0) {
+            s.shownAction = s.action;
+            s.shownFrame = s.frame;
+        }
+    }
+
+    // Player/Enemy::update followed by Character::update
+    void update(FighterState& s, const FighterModel& m, FighterInput input, float dt, float windowWidth) {
+        if (s.alive && !s.hurt) {
+            bool moving = false;
+            if (!s.attacking && !s.shielding) {
+                float moveSpeed = GameConfig::MOVEMENT_SPEED * (input.has(FighterInput::RUN) ?
+                                  GameConfig::RUN_BOOST_MULTIPLIER : 1.f) * dt * 60.f;
+                if (input.has(FighterInput::LEFT)) { s.x -= moveSpeed; moving = true; s.facingRight = false; }
+                if (input.has(FighterInput::RIGHT)) { s.x += moveSpeed; moving = true; s.facingRight = true; }
+                if (input.has(FighterInput::JUMP) && !s.jumping) {
+                    s.jumping = true;
+                    s.verticalVelocity = GameConfig::JUMP_STRENGTH;
+                }
+            }
+            if (!s.attacking && !s.shielding) {
+                if (s.jumping) s.action = Character::Action::JUMP;
+                else if (moving) s.action = Character::Action::RUN;
+                else s.action = Character::Action::IDLE;
+            } else if (s.shielding) {
+                s.action = Character::Action::SHIELD;
+            }
+        }
+
+        Character::Action previous = s.action;
+        if (!s.alive) {
+            s.action = Character::Action::DEAD;
+        } else if (s.hurt) {
+            s.action = Character::Action::HURT;
+            if (sf::microseconds(s.hurtUs).asSeconds() >= m.clip(Character::Action::HURT).length) {
+                s.hurt = false;
+                s.action = Character::Action::IDLE;
+            }
+        }
+
+        if (s.alive && !s.hurt) {
+            if (!s.canAttack && sf::microseconds(s.attackCooldownUs).asSeconds() > 0.8f) s.canAttack = true;
+
+            if (s.jumping) {
+                s.verticalVelocity += GameConfig::GRAVITY * dt * 60.f;
+                s.y += s.verticalVelocity * dt * 60.f;
+                if (s.y >= m.groundY) {
+                    s.y = m.groundY;
+                    s.jumping = false;
+                    s.verticalVelocity = 0.f;
+                    if (!s.attacking && !s.shielding && s.action == Character::Action::JUMP) s.action = Character::Action::IDLE;
+                } else if (!s.attacking && s.action != Character::Action::HURT) {
+                    s.action = Character::Action::JUMP;
+                }
+            }
+        }
+
+        if (previous != s.action) {
+            s.frame = 0;
+            s.animTime = 0.f;
+        }
+
+        float width = m.clip(s.shownAction).frames[s.shownFrame].width * m.scale;
+        if (s.x < 0.f) s.x = 0.f;
+        if (s.x + width > windowWidth) s.x = windowWidth - width;
+
+        advanceAnimation(s, m, dt);
+    }
+
+    // GamePlayScreen::resolveAttack with Character::takeDamage
+    bool resolveAttack(FighterState& attacker, const FighterModel& attackerModel, FighterState& defender, const FighterModel& defenderModel,
+                       bool pixelPrecise = false) {
+        if (!attacker.attacking || attacker.dealtDamage) return false;
+        sf::FloatRect overlap;
+        if (!defender.alive || !attacker.attackHitbox(attackerModel, attacker.facingRight).intersects(defender.hurtbox(defenderModel), overlap)) return false;
+        if (pixelPrecise && !FrameMask::overlap(attacker.mask(attackerModel), attacker.pixelPosition(), defender.mask(defenderModel),
+                                                defender.pixelPosition(), FrameMask::covering(overlap))) return false;
+
+        if (!defender.shielding) {
+            defender.health -= GameConfig::ATTACK_DAMAGE;
+            defender.hurt = true;
+            defender.hurtUs = 0;
+            defender.attacking = false;
+            if (defender.health <= 0.f) {
+                defender.health = 0.f;
+                defender.alive = false;
+                defender.hurt = false;
+            }
+        }
+        attacker.dealtDamage = true;
+        return true;
+    }
+
+    // One match tick, in GamePlayScreen::update's order
+    void step(MatchState& match, FighterInput player, FighterInput enemy, float dt) {
+        FighterState& p = match.fighters[0];
+        FighterState& e = match.fighters[1];
+        std::int64_t dtUs = sf::seconds(dt).asMicroseconds(); // SimClock advances before the screen updates
+        for (FighterState* s : {&p, &e}) {
+            s->attackCooldownUs += dtUs;
+            s->hurtUs += dtUs;
+        }
+        applyButtons(p, player);
+        applyButtons(e, enemy);
+
+        float windowWidth = static_cast<float>(GameConfig::WINDOW_WIDTH);
+        update(p, match.models[0], player, dt, windowWidth);
+        update(e, match.models[1], enemy, dt, windowWidth);
+
+        resolveAttack(p, match.models[0], e, match.models[1], match.pixelPreciseHits);
+        resolveAttack(e, match.models[1], p, match.models[0], match.pixelPreciseHits);
+    }
+
+    MatchState capture(const Character& player, const Character& enemy) {
+        MatchState match;
+        match.fighters[0] = FighterState::capture(player);
+        match.fighters[1] = FighterState::capture(enemy);
+        match.models[0] = FighterModel::of(player);
+        match.models[1] = FighterModel::of(enemy);
+        match.pixelPreciseHits = GameConfig::PIXEL_PRECISE_HITS;
+        return match;
+    }
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Enums.h"
+#include "GameConfig.h"
+
+// --- Flight Recorder ---
+// Always-on, fixed-size history of per-frame phase timings, screen state and asset loads. When a
+// frame (or a simulation tick) blows HITCH_BUDGET_MS, the last HITCH_HISTORY_SECONDS are written
+// to hitch_<date>_<time>.csv so field reports come with a timeline. Recording is a copy into a ring
+// under an uncontended lock; reports are written on a helper thread so they don't add to the hitch.
+class FlightRecorder {
+public:
+    static constexpr std::size_t FRAME_CAPACITY = 2048; // > HITCH_HISTORY_SECONDS at 240 Hz
+    static constexpr std::size_t ASSET_CAPACITY = 256;
+
+    struct FrameRecord {
+        std::int64_t timeUs;
+        float frameMs, eventsMs, updateMs, transitionMs, renderMs;
+        unsigned int drawCalls;
+        GameStateID state;
+        TransitionState transition;
+        int backgroundFrame;
+    };
+
+    struct AssetRecord {
+        std::int64_t timeUs; // When the load finished
+        float durationMs;
+        const char* name;
+        char detail[64];
+    };
+
+    // Records the end of an asset load for the report; used by ResourceManager
+    class AssetLoad {
+    public:
+        AssetLoad(const char* loadName, const std::string& loadDetail)
+            : name(loadName), startUs(nowUs()) {
+            std::strncpy(detail, loadDetail.c_str(), sizeof(detail) - 1);
+            detail[sizeof(detail) - 1] = '\0';
+        }
+        ~AssetLoad() { global().recordAsset(name, detail, startUs, nowUs()); }
+
+        AssetLoad(const AssetLoad&) = delete;
+        AssetLoad& operator=(const AssetLoad&) = delete;
+
+    private:
+        const char* name;
+        char detail[sizeof(AssetRecord::detail)]; // Copied on entry, so temporaries (prefix + name) are fine
+        std::int64_t startUs;
+    };
+
+    static FlightRecorder& global() {
+        static FlightRecorder recorder;
+        return recorder;
+    }
+
+    static std::int64_t nowUs() {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    ~FlightRecorder() {
+        if (writer.joinable()) writer.join();
+    }
+
+    void recordFrame(const FrameRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames[framesWritten % FRAME_CAPACITY] = record;
+        ++framesWritten;
+    }
+
+    void recordAsset(const char* name, const char* detail, std::int64_t startUs, std::int64_t endUs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        AssetRecord& record = assets[assetsWritten % ASSET_CAPACITY];
+        record.timeUs = endUs;
+        record.durationMs = (endUs - startUs) / 1000.f;
+        record.name = name;
+        std::strncpy(record.detail, detail, sizeof(record.detail) - 1);
+        record.detail[sizeof(record.detail) - 1] = '\0';
+        ++assetsWritten;
+    }
+
+    // Writes a report if `measuredMs` is over budget and the last report wasn't too recent.
+    // Returns true if a report was started.
+    bool checkHitch(const char* what, float measuredMs) {
+        if (measuredMs <= GameConfig::HITCH_BUDGET_MS) return false;
+        std::int64_t now = nowUs();
+        if (lastReportUs != 0 && now - lastReportUs < static_cast<std::int64_t>(GameConfig::HITCH_REPORT_COOLDOWN * 1e6f)) return false;
+        lastReportUs = now;
+
+        // Copy the window out under the lock, then format and write off-thread
+        std::int64_t windowStart = now - static_cast<std::int64_t>(GameConfig::HITCH_HISTORY_SECONDS * 1e6f);
+        std::vector<FrameRecord> frameCopy;
+        std::vector<AssetRecord> assetCopy;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::size_t count = std::min(framesWritten, FRAME_CAPACITY);
+            for (std::size_t i = framesWritten - count; i < framesWritten; ++i) {
+                const FrameRecord& f = frames[i % FRAME_CAPACITY];
+                if (f.timeUs >= windowStart) frameCopy.push_back(f);
+            }
+            count = std::min(assetsWritten, ASSET_CAPACITY);
+            for (std::size_t i = assetsWritten - count; i < assetsWritten; ++i) {
+                const AssetRecord& a = assets[i % ASSET_CAPACITY];
+                if (a.timeUs >= windowStart) assetCopy.push_back(a);
+            }
+        }
+
+        char trigger[128];
+        std::snprintf(trigger, sizeof(trigger), "%s %.1f ms (budget %.1f ms) at t=%.3f s",
+                      what, measuredMs, GameConfig::HITCH_BUDGET_MS, now / 1e6);
+        std::string reason = trigger;
+
+        if (writer.joinable()) writer.join();
+        writer = std::thread([frameCopy, assetCopy, reason]() {
+            writeReport(frameCopy, assetCopy, reason);
+        });
+        return true;
+    }
+
+    // Asset loads that finished at or after `sinceUs` and are still in the ring, oldest first
+    std::vector<AssetRecord> assetsSince(std::int64_t sinceUs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<AssetRecord> result;
+        std::size_t count = std::min(assetsWritten, ASSET_CAPACITY);
+        for (std::size_t i = assetsWritten - count; i < assetsWritten; ++i) {
+            if (assets[i % ASSET_CAPACITY].timeUs >= sinceUs) result.push_back(assets[i % ASSET_CAPACITY]);
+        }
+        return result;
+    }
+
+    static const char* stateName(GameStateID state) {
+        switch (state) {
+            case GameStateID::MENU: return "MENU";
+            case GameStateID::NAME_INPUT: return "NAME_INPUT";
+            case GameStateID::NAME_INPUT_P2: return "NAME_INPUT_P2";
+            case GameStateID::MODE_SELECTION: return "MODE_SELECTION";
+            case GameStateID::CHARACTER_SELECTION: return "CHARACTER_SELECTION";
+            case GameStateID::MAP_SELECTION: return "MAP_SELECTION";
+            case GameStateID::GAME_PLAY: return "GAME_PLAY";
+            case GameStateID::PAUSE: return "PAUSE";
+            case GameStateID::GAME_OVER: return "GAME_OVER";
+        }
+        return "?";
+    }
+
+private:
+    std::mutex mutex;
+    FrameRecord frames[FRAME_CAPACITY];
+    std::size_t framesWritten = 0;
+    AssetRecord assets[ASSET_CAPACITY];
+    std::size_t assetsWritten = 0;
+    std::int64_t lastReportUs = 0; // Render thread only
+    std::thread writer;
+
+    FlightRecorder() = default;
+
+    static const char* transitionName(TransitionState transition) {
+        switch (transition) {
+            case TransitionState::NONE: return "NONE";
+            case TransitionState::FADING_OUT: return "FADING_OUT";
+            case TransitionState::FADING_IN: return "FADING_IN";
+        }
+        return "?";
+    }
+
+    static void writeReport(const std::vector<FrameRecord>& frameCopy, const std::vector<AssetRecord>& assetCopy,
+                            const std::string& reason) {
+        std::time_t wallClock = std::time(nullptr);
+        char fileName[64];
+        std::strftime(fileName, sizeof(fileName), "hitch_%Y%m%d_%H%M%S.csv", std::localtime(&wallClock));
+
+        std::FILE* out = std::fopen(fileName, "w");
+        if (!out) {
+            std::cerr << "Failed to write hitch report " << fileName << std::endl;
+            return;
+        }
+        std::fprintf(out, "# HellFire-Clash hitch report\n# trigger: %s\n", reason.c_str());
+        std::fprintf(out, "# frames\ntime_ms,frame_ms,events_ms,update_ms,transition_ms,render_ms,draw_calls,state,transition,bg_frame\n");
+        for (const FrameRecord& f : frameCopy) {
+            std::fprintf(out, "%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%u,%s,%s,%d\n", f.timeUs / 1000.0, f.frameMs, f.eventsMs, f.updateMs,
+                         f.transitionMs, f.renderMs, f.drawCalls, stateName(f.state), transitionName(f.transition), f.backgroundFrame);
+        }
+        std::fprintf(out, "# asset loads\nend_ms,duration_ms,name,detail\n");
+        for (const AssetRecord& a : assetCopy) {
+            std::fprintf(out, "%.3f,%.3f,%s,%s\n", a.timeUs / 1000.0, a.durationMs, a.name, a.detail);
+        }
+        std::fclose(out);
+        std::cout << "Hitch report written to " << fileName << " (" << reason << ")" << std::endl;
+    }
+};
@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <SFML/Graphics.hpp>
+#include "GameConfig.h"
+
+enum class PacingMode {
+    VSYNC,      // Driver paces presents to the display refresh
+    LIMITER,    // No VSync; our own sleep-then-spin limiter holds FRAMERATE_LIMIT
+    LATE_LATCH  // VSync, but the frame is started as late as possible before the next vblank
+};
+
+// --- Latency Stats ---
+// Rolling window of input-to-present latencies, one sample per presented gameplay frame
+struct LatencyStats {
+    static constexpr int WINDOW = 128;
+
+    sf::Time samples[WINDOW];
+    int count = 0;
+    int next = 0;
+    sf::Time last;
+
+    void add(sf::Time latency) {
+        last = latency;
+        samples[next] = latency;
+        next = (next + 1) % WINDOW;
+        if (count < WINDOW) ++count;
+    }
+
+    sf::Time average() const {
+        if (count == 0) return sf::Time::Zero;
+        sf::Int64 total = 0;
+        for (int i = 0; i < count; ++i) total += samples[i].asMicroseconds();
+        return sf::microseconds(total / count);
+    }
+
+    sf::Time worst() const {
+        sf::Time result;
+        for (int i = 0; i < count; ++i) result = std::max(result, samples[i]);
+        return result;
+    }
+
+    void clear() { count = next = 0; last = sf::Time::Zero; }
+};
+
+// --- Frame Pacer ---
+// Owns how the render thread paces its presents. Hooks, in frame order:
+//   waitForLatch()    - before the newest snapshot is picked up (LATE_LATCH sleeps here)
+//   waitForPresent()  - after drawing, right before display() (LIMITER sleeps here)
+//   framePresented()  - after display() returns; records refresh timing and latency
+// All times are on the game's shared timeline clock.
+class FramePacer {
+public:
+    const sf::Time SPIN_THRESHOLD = sf::milliseconds(2); // Sleep until this close to a deadline, then spin
+    const sf::Time LATCH_MARGIN = sf::microseconds(1500); // Slack on top of the measured draw time
+
+    PacingMode mode = PacingMode::VSYNC;
+    LatencyStats latency;
+
+    // Applies the mode's window settings. The built-in frame-rate limit is never used: it fought VSync.
+    void apply(sf::RenderWindow& window) {
+        window.setFramerateLimit(0);
+        window.setVerticalSyncEnabled(mode != PacingMode::LIMITER);
+        latency.clear();
+        lastDeadline = sf::Time::Zero;
+    }
+
+    void cycleMode(sf::RenderWindow& window) {
+        mode = (mode == PacingMode::VSYNC) ? PacingMode::LIMITER :
+               (mode == PacingMode::LIMITER) ? PacingMode::LATE_LATCH : PacingMode::VSYNC;
+        apply(window);
+    }
+
+    const char* modeName() const {
+        switch (mode) {
+            case PacingMode::VSYNC: return "VSync";
+            case PacingMode::LIMITER: return "Limiter";
+            case PacingMode::LATE_LATCH: return "Late latch";
+        }
+        return "?";
+    }
+
+    // LATE_LATCH: wait until the predicted next vblank minus the time a frame takes to draw, so
+    // the snapshot drawn (and the input in it) is as fresh as possible when it reaches the screen
+    void waitForLatch(const sf::Clock& timeline) {
+        if (mode == PacingMode::LATE_LATCH && lastPresent > sf::Time::Zero) {
+            sf::Time latchAt = lastPresent + refreshPeriod - drawBudget - LATCH_MARGIN;
+            preciseWaitUntil(timeline, latchAt);
+        }
+        latchTime = timeline.getElapsedTime();
+    }
+
+    // LIMITER: hold presents to FRAMERATE_LIMIT with a sleep-then-spin wait
+    void waitForPresent(const sf::Clock& timeline) {
+        sf::Time now = timeline.getElapsedTime();
+
+        // Track how long drawing takes (fast attack, slow decay) for the late-latch budget
+        sf::Time drawTime = now - latchTime;
+        drawBudget = (drawTime > drawBudget) ? drawTime : drawBudget - (drawBudget - drawTime) / static_cast<sf::Int64>(16);
+
+        if (mode != PacingMode::LIMITER) return;
+        sf::Time period = sf::seconds(1.0f / GameConfig::FRAMERATE_LIMIT);
+        lastDeadline += period;
+        if (lastDeadline < now - period) lastDeadline = now; // Too far behind: re-anchor instead of bursting
+        preciseWaitUntil(timeline, lastDeadline);
+    }
+
+    // `inputTime` is when the input in the displayed frame was sampled; zero if the frame had none
+    void framePresented(const sf::Clock& timeline, sf::Time inputTime) {
+        sf::Time now = timeline.getElapsedTime();
+        if (lastPresent > sf::Time::Zero && mode != PacingMode::LIMITER) {
+            // With VSync, display() returns at the vblank: track the refresh period from that,
+            // ignoring missed vblanks and stalls
+            sf::Time interval = now - lastPresent;
+            if (interval > sf::milliseconds(3) && interval < refreshPeriod + refreshPeriod / static_cast<sf::Int64>(2)) {
+                refreshPeriod += (interval - refreshPeriod) / static_cast<sf::Int64>(8);
+            }
+        }
+        lastPresent = now;
+        if (inputTime > sf::Time::Zero) latency.add(now - inputTime);
+    }
+
+    void printLatency(std::ostream& out) const {
+        out << "Frame pacing: " << modeName()
+            << " | input-to-present latency last " << latency.last.asMicroseconds() / 1000.f
+            << " ms, avg " << latency.average().asMicroseconds() / 1000.f
+            << " ms, worst " << latency.worst().asMicroseconds() / 1000.f
+            << " ms over " << latency.count << " frames" << std::endl;
+    }
+
+private:
+    sf::Time refreshPeriod = sf::seconds(1.0f / 60.0f); // Measured from VSync'd presents
+    sf::Time drawBudget = sf::milliseconds(2);
+    sf::Time lastPresent;
+    sf::Time latchTime;
+    sf::Time lastDeadline;
+
+    // sf::sleep alone overshoots by up to a scheduler quantum, so sleep most of the way and spin the rest
+    void preciseWaitUntil(const sf::Clock& timeline, sf::Time deadline) const {
+        sf::Time remaining = deadline - timeline.getElapsedTime();
+        if (remaining > SPIN_THRESHOLD) sf::sleep(remaining - SPIN_THRESHOLD);
+        while (timeline.getElapsedTime() < deadline) std::this_thread::yield();
+    }
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <SFML/System.hpp>
+
+// --- Frame Scheduler ---
+// Decides whether the game should produce a frame now. Animating screens (gameplay, the
+// bobbing title) run at the full rate; screens that only change every so often report an
+// idle redraw interval and are advanced at that rate instead. Any input snaps back to the full
+// rate immediately and keeps it for a short grace period so hover and typing stay responsive.
+// Input is reported from the event thread while the simulation thread asks for frames, so the
+// timestamps are atomics measured against one shared clock.
+class FrameScheduler {
+public:
+    const sf::Time INPUT_GRACE = sf::seconds(0.25f);  // Full rate for this long after the last input
+    const sf::Time POLL_SLICE = sf::milliseconds(5);  // Sleep between event polls while idle
+
+    void notifyInput() {
+        lastInputUs.store(epoch.getElapsedTime().asMicroseconds(), std::memory_order_relaxed);
+    }
+
+    // `idleInterval` of zero means the screen is animating and wants every frame
+    bool isFrameDue(sf::Time idleInterval, bool forceFullRate) const {
+        if (forceFullRate || idleInterval == sf::Time::Zero) return true;
+        sf::Int64 now = epoch.getElapsedTime().asMicroseconds();
+        if (now - lastInputUs.load(std::memory_order_relaxed) < INPUT_GRACE.asMicroseconds()) return true;
+        return now - lastFrameUs.load(std::memory_order_relaxed) >= idleInterval.asMicroseconds();
+    }
+
+    void frameProduced() {
+        lastFrameUs.store(epoch.getElapsedTime().asMicroseconds(), std::memory_order_relaxed);
+    }
+
+    // Called instead of rendering; returns quickly enough that new input is picked up within a slice
+    void idle() const {
+        sf::sleep(POLL_SLICE);
+    }
+
+private:
+    sf::Clock epoch; // Only read after construction
+    std::atomic<sf::Int64> lastInputUs{0};
+    std::atomic<sf::Int64> lastFrameUs{0};
+};
@@ -1,6 +1,25 @@
 #include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
 #include "Character.h"
 #include "DamageText.h"
+#include "FighterAI.h"
+#include "SearchAI.h"
+#include "BotLink.h"
+#include "PolicyTable.h"
+#include "ShadowAI.h"
+#include "HudBatch.h"
+#include "FrameScheduler.h"
+#include "FramePacer.h"
+#include "PerfOverlay.h"
+#include "Trace.h"
+#include "FlightRecorder.h"
+#include "GameDriver.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
 #include "ResourceManager.h"
 
 class Game; // Forward declaration of Game class
@@ -10,11 +29,16 @@ public:
     virtual ~Screen() = default;
     // gamePtr is a pointer to the Game instance, allowing screens to interact with game state.
     virtual void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) = 0;
+    // Runs on the simulation thread; mousePos is already mapped to game (virtual 1280x720) coordinates
     virtual void update(sf::Time dt, sf::Vector2f mousePos, Player& player, Enemy& enemy, GameStateID& gameResultState, Game* gamePtr = nullptr) = 0;
-    virtual void draw(sf::RenderWindow& window, const Player& player, const Enemy& enemy) = 0;
+    // Draws to any render target: the window, or an off-screen texture (e.g. the cached pause frame)
+    virtual void draw(sf::RenderTarget& window, const Player& player, const Enemy& enemy) = 0;
     // onEnter method, with `data` for context specific information (e.g., game outcome in GameOverScreen)
     virtual void onEnter(const sf::RenderWindow& window, Player& player, Enemy& enemy, const std::string& data = "") {}
     virtual void onExit() {}
+    // How often the screen must be redrawn when there is no input. Zero means it is animating
+    // and wants every frame; anything else lets Game::run drop to that rate while idle.
+    virtual sf::Time getIdleRedrawInterval() const { return sf::Time::Zero; }
     // onResize method, now takes virtual width/height for layout calculations
     virtual void onResize(unsigned int width, unsigned int height, Player& player, Enemy& enemy) = 0;
 };
@@ -29,13 +53,24 @@ public:
     GameStateID nextStateID;
     GameStateID gameResultState = GameStateID::GAME_PLAY; // Flag for game over condition check in Game::run
     GameMode currentMode = GameMode::PvAI;
+    AIDifficulty aiDifficulty = AIDifficulty::NORMAL; // Chosen on the mode selection screen
+
+    // Plays the enemy in PvAI matches; created at match start from aiDifficulty
+    std::unique_ptr<FighterAI> enemyAI;
+    AIBudget aiBudget;
+    PolicyTable policyTable; // Loaded by the first "Table" match
+    ShadowRecorder shadowRecording; // Player 1's controls this match (PvAI, keyboard only)
+    ShadowTrainer shadowTrainer;    // Folds finished recordings into each player's habits off-thread
+    BotLink botLink; // Made by the first "Bot" match and kept, so an attached bot survives rematches
 
     TransitionState currentTransition;
     sf::Clock transitionClock;
     sf::RectangleShape transitionRect;
 
     float gameTimeScale = 1.0f;
-    sf::Clock gameClock;
+    sf::Clock gameClock; // Wall-clock dt for menus; gameplay always advances by SIM_TICK
+    const sf::Time SIM_TICK = sf::seconds(1.0f / GameConfig::SIMULATION_TICK_RATE);
+    const int MAX_CATCHUP_TICKS = 5; // After a longer stall the backlog is dropped rather than fast-forwarded
 
     Player player;
     Enemy enemy;
@@ -45,6 +80,8 @@ public:
     // Character selection storage
     CharacterTypeID selectedPlayer1Char = CharacterTypeID::KNIGHT;
     CharacterTypeID selectedEnemyChar = CharacterTypeID::ROGUE;
+    int selectedPlayer1Costume = 0; // Rows of the presets' palettes (Costumes in Palette.h)
+    int selectedEnemyCostume = 0;
 
     std::vector<sf::Texture> map1Frames, map2Frames, map3Frames; // Added map3Frames
     bool map1Loaded = false, map2Loaded = false, map3Loaded = false; // Added map3Loaded
@@ -56,9 +93,54 @@ public:
     const float MAP_FRAME_DELAY = 0.11f;
 
     bool isShaking = false;
-    sf::Clock shakeClock;
+    SimClock shakeClock;
     sf::Vector2f shakeOffset;
 
+    FrameScheduler frameScheduler; // Drops to a low update/redraw rate on idle menus
+    FramePacer framePacer; // VSync / limiter / late-latch presents, and input-to-present latency (F3 cycles)
+    PerfOverlay perfOverlay; // F2: frame-time graph and per-phase timings
+
+    // Threading: the simulation (update, transitions, game-over checks) ticks on its own thread,
+    // while this thread polls window events and renders. Gameplay is drawn from snapshots
+    // handed over through `snapshots`, so drawing never waits on a tick and vice versa.
+    std::mutex simMutex;    // Guards screens, fighters and game state; held by a tick, by event handling and by menu rendering
+    std::mutex assetMutex;  // Held while snapshot sprites are drawn and while the textures they point at are reloaded
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::atomic<bool> simulationRunning{false};
+    bool traceDumpRequested = false;          // F4, handled once simMutex is released
+    std::atomic<bool> traceDumpRunning{false};
+    std::thread traceWriter;                  // Writes F4 dumps so neither thread waits on the disk
+    std::atomic<std::uint64_t> frameSerial{0}; // Bumped after every tick; the renderer skips frames with nothing new
+    std::uint64_t lastRenderedSerial = 0;
+    bool renderInterpolating = false; // Last frame was mid-way between ticks, so the next one differs even without a new tick
+    std::uint64_t simTick = 0;
+    sf::Clock timeline; // Shared time base for snapshot timestamps; never restarted
+    sf::Vector2f tickStartPositions[2]; // Fighter positions before the current tick's update
+    sf::Vector2f lastPublishedShake;
+    sf::Time inputSampledAt; // When the current tick's fighter input was read, on `timeline`
+
+    // Phase timings for the perf overlay. The simulation's are handed over in each snapshot.
+    sf::Time lastUpdateTime, lastTransitionTime; // Simulation thread
+    sf::Time lastEventsTime, lastPresentAt;      // Render thread
+    sf::Time idleSinceLastFrame; // Time the render thread chose to wait since the last present (not a hitch on menus)
+    AllocTracker::Counters frameAllocStart; // Render thread's allocation count at the last present
+    AllocTracker::Counters lastTickAllocations; // Heap allocations of the last whole tick (HELLFIRE_TRACK_ALLOCS builds)
+    sf::View gameView; // Letterboxed view from handleResize, so the simulation can map the mouse without touching the window's view
+
+    // Scripted runs (the end-to-end harness): events and fighter controls come from the driver
+    // instead of the window and keyboard. Null when someone is playing.
+    GameDriver* driver = nullptr;
+    std::vector<sf::Event> injectedEvents; // Reused every frame
+    bool measureGpuTime = false; // Wait for the GPU before each present and report how long it took
+    // `--report`: print pacing latency, AI budget and allocation stats on exit and when F3 leaves a
+    // mode, and say where trace dumps went. Off by default; the F2 overlay shows the live numbers.
+    bool consoleReport = false;
+
+    // Last gameplay frame, captured once when the game is paused and shown under the pause menu
+    sf::RenderTexture pauseFrame;
+    sf::Sprite pauseFrameSprite;
+    bool pauseFrameValid = false;
+
     Game();
     void run();
     void triggerScreenShake();
@@ -66,12 +148,21 @@ public:
 
 private:
     void processEvents();
+    void handleEvent(sf::Event& event);
+    void simulationLoop();
+    void simulationStep();
+    void publishSnapshot();
+    void checkGameOver();
+    void dumpTrace();
+    void startTraceDump();
+    void recordFlight(const RenderSnapshot& snap, const PerfOverlay::Sample& sample, bool freshTick);
     void update(sf::Time dt);
     void render();
     void changeScreen(GameStateID newStateID, const std::string& onEnterData = ""); // Added optional data for onEnter
     void handleScreenTransition(sf::Time dt);
     void handleResize(unsigned int width, unsigned int height);
     void updateScreenShake(sf::Time dt);
+    bool capturePauseFrame();
 };
 
 
@@ -81,6 +172,7 @@ public:
     sf::Text promptText;
     sf::RectangleShape pvaButton, pvpButton;
     sf::Text pvaText, pvpText;
+    sf::Text difficultyText; // AI difficulty for PvAI; Left/Right or a click cycles it
     sf::RenderWindow& m_windowRef;
 
     sf::Color defaultBtnColor = sf::Color::Black;
@@ -125,6 +217,13 @@ public:
         pvpText.setOutlineThickness(2);              // Prominent outline
         Utils::centerOrigin(pvpText);
 
+        difficultyText.setFont(ResourceManager::getFont("ariblk.ttf"));
+        difficultyText.setCharacterSize(30);
+        difficultyText.setFillColor(sf::Color::White);
+        difficultyText.setOutlineColor(sf::Color::Black);
+        difficultyText.setOutlineThickness(2);
+        setDifficultyLabel(AIDifficulty::NORMAL);
+
         ResourceManager::loadMenuBackgroundFrames(bgFrames, 12);
         if (!bgFrames.empty()) {
             background.setTexture(bgFrames[0]);
@@ -150,6 +249,8 @@ public:
         pvpButton.setPosition(width / 2.0f - pvpButton.getSize().x / 2.0f, buttonYStart + pvaButton.getSize().y + buttonGap);
         pvpText.setPosition(pvpButton.getPosition().x + pvpButton.getSize().x / 2.0f, pvpButton.getPosition().y + pvpButton.getSize().y / 2.0f);
 
+        difficultyText.setPosition(width / 2.0f, pvpButton.getPosition().y + pvpButton.getSize().y + buttonGap + 20);
+
         if (background.getTexture()) {
             background.setOrigin(0,0);
             background.setScale(
@@ -162,7 +263,7 @@ public:
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
         if (event.type == sf::Event::MouseButtonPressed) {
             if (gamePtr) {
-                sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+                sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
                 // Transform mouse position to game coordinates for accurate hit detection
                 sf::View gameView = window.getView();
                 mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -175,8 +276,12 @@ public:
                     gamePtr->currentMode = GameMode::PvP;
                     nextState = GameStateID::CHARACTER_SELECTION; // Go to character selection
                     wantsTransition = true;
+                } else if (difficultyText.getGlobalBounds().contains(mousePos)) {
+                    cycleDifficulty(gamePtr, 1);
                 }
             }
+        } else if (event.type == sf::Event::KeyPressed && (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::Right)) {
+            if (gamePtr) cycleDifficulty(gamePtr, event.key.code == sf::Keyboard::Right ? 1 : -1);
         } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
             nextState = GameStateID::NAME_INPUT; // Go back to Player 1 name input
             wantsTransition = true;
@@ -184,9 +289,7 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr) override {
-        // Transform mouse position to game coordinates for hover effect
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i for mapPixelToCoords
+        TRACE_SCOPE("ModeSelectionScreen::update");
 
         pvaButton.setFillColor(pvaButton.getGlobalBounds().contains(mousePos) ? hoverBtnColor : defaultBtnColor);
         pvpButton.setFillColor(pvpButton.getGlobalBounds().contains(mousePos) ? hoverBtnColor : defaultBtnColor);
@@ -201,13 +304,31 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(background.getTexture()) window.draw(background);
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(BG_FRAME_DELAY); // Only the background animation changes between inputs
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("ModeSelectionScreen::draw");
+        if(background.getTexture()) RenderStats::draw(window, background);
         else window.clear(sf::Color(20, 20, 40));
 
-        window.draw(promptText);
-        window.draw(pvaButton); window.draw(pvaText);
-        window.draw(pvpButton); window.draw(pvpText);
+        RenderStats::draw(window, promptText);
+        RenderStats::draw(window, pvaButton); RenderStats::draw(window, pvaText);
+        RenderStats::draw(window, pvpButton); RenderStats::draw(window, pvpText);
+        RenderStats::draw(window, difficultyText);
+    }
+
+private:
+    void cycleDifficulty(Game* gamePtr, int step) {
+        int count = static_cast<int>(AIDifficulty::BOT) + 1;
+        gamePtr->aiDifficulty = static_cast<AIDifficulty>((static_cast<int>(gamePtr->aiDifficulty) + step + count) % count);
+        setDifficultyLabel(gamePtr->aiDifficulty);
+    }
+
+    void setDifficultyLabel(AIDifficulty difficulty) {
+        difficultyText.setString(std::string("AI: < ") + aiProfile(difficulty).name + " >");
+        Utils::centerOrigin(difficultyText);
     }
 };
 
@@ -280,6 +401,7 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr = nullptr) override {
+        TRACE_SCOPE("MenuScreen::update");
         float time = menuAnimClock.getElapsedTime().asSeconds();
         // Use GameConfig::WINDOW_WIDTH/HEIGHT as the base for positioning
         title.setPosition(GameConfig::WINDOW_WIDTH / 2.0f, GameConfig::WINDOW_HEIGHT * 0.25f + 12.f * std::sin(time * 2.8f));
@@ -297,10 +419,11 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(background.getTexture()) window.draw(background);
-        window.draw(title);
-        window.draw(pressStart);
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("MenuScreen::draw");
+        if(background.getTexture()) RenderStats::draw(window, background);
+        RenderStats::draw(window, title);
+        RenderStats::draw(window, pressStart);
     }
 };
 
@@ -421,7 +544,7 @@ public:
 
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
         if (event.type == sf::Event::MouseButtonPressed) {
-            sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+            sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
             // Transform mouse position to game coordinates for accurate hit detection
             sf::View gameView = window.getView();
             mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -482,9 +605,7 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr = nullptr) override {
-        // Transform mouse position to game coordinates for input box focus
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i
+        TRACE_SCOPE("NameInputScreen::update");
 
         inputBox.setOutlineColor(isActive ? sf::Color::Yellow : sf::Color(150, 150, 150)); // Highlight if active
         if (isActive && cursorBlinkClock.getElapsedTime().asSeconds() > 0.53f) {
@@ -502,12 +623,17 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(background.getTexture()) window.draw(background);
-        window.draw(promptText);
-        window.draw(inputBox);
-        window.draw(nameDisplay);
-        window.draw(nameLengthHint);
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(BG_FRAME_DELAY); // Background frames and the cursor blink are all that change
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("NameInputScreen::draw");
+        if(background.getTexture()) RenderStats::draw(window, background);
+        RenderStats::draw(window, promptText);
+        RenderStats::draw(window, inputBox);
+        RenderStats::draw(window, nameDisplay);
+        RenderStats::draw(window, nameLengthHint);
 
         if (isActive && showCursor) {
             sf::Vector2f charPos = nameDisplay.findCharacterPos(playerNameRef.length());
@@ -518,7 +644,7 @@ public:
             if (playerNameRef.empty()) { cursorX = minCursorX; }
             cursorX = Utils::clamp(cursorX, minCursorX, maxCursorX);
             cursorText.setPosition(cursorX, cursorY);
-            window.draw(cursorText);
+            RenderStats::draw(window, cursorText);
         }
 
         bool showContinue = false;
@@ -532,7 +658,7 @@ public:
         }
 
         if (showContinue) {
-            window.draw(continueText);
+            RenderStats::draw(window, continueText);
         }
     }
     Game* gamePtr = nullptr; // For checking current state in draw
@@ -546,6 +672,7 @@ public:
     sf::RectangleShape char1Frame, char2Frame, char3Frame;
     sf::Sprite char1TitleSprite, char2TitleSprite, char3TitleSprite;
     sf::Text char1NameText, char2NameText, char3NameText;
+    sf::Text costumeText; // Costume for the character being picked; Left/Right (or a click) cycles it
 
     sf::Color frameColor = sf::Color(50, 50, 50, 130);
     sf::Color frameHoverColor = sf::Color(80, 80, 80, 180);
@@ -565,6 +692,7 @@ public:
     // Temporary selections before applying to Game
     CharacterTypeID tempP1CharType;
     CharacterTypeID tempP2CharType;
+    int tempCostumes[2] = {0, 0}; // Per selection step, rows of Costumes (Palette.h)
 
 private:
     sf::Texture char1TitleTexture, char2TitleTexture, char3TitleTexture;
@@ -627,6 +755,11 @@ public:
         char3NameText.setOutlineThickness(2);              // Prominent outline
         Utils::centerOrigin(char3NameText);
 
+        costumeText.setFont(ResourceManager::getFont("ariblk.ttf"));
+        costumeText.setCharacterSize(26);
+        costumeText.setFillColor(sf::Color::White);
+        costumeText.setOutlineColor(sf::Color::Black);
+        costumeText.setOutlineThickness(2);
 
         ResourceManager::loadMenuBackgroundFrames(bgFrames, 12);
         if (!bgFrames.empty()) {
@@ -642,6 +775,7 @@ public:
         currentSelectionStep = 0; // Start with Player 1 selection
         tempP1CharType = CharacterTypeID::KNIGHT; // Default to Knight
         tempP2CharType = CharacterTypeID::ROGUE; // Default to Rogue (for AI or P2)
+        tempCostumes[0] = tempCostumes[1] = 0;
 
         // Pass virtual resolution to onResize
         onResize(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT, playerRef, enemyRef);
@@ -700,6 +834,9 @@ public:
         char3NameText.setPosition(char3Frame.getPosition().x + char3Frame.getSize().x / 2.0f,
                                   char3Frame.getPosition().y + titleImageYOffset + titleImageHeight + 25.0f);
 
+        refreshCostumeText();
+        costumeText.setPosition(width / 2.0f, charY + char1Frame.getSize().y + 50.0f);
+
         if (background.getTexture()) {
             background.setOrigin(0,0);
             background.setScale(
@@ -711,7 +848,7 @@ public:
 
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
         if (event.type == sf::Event::MouseButtonPressed) {
-            sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+            sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
             // Transform mouse position to game coordinates for accurate hit detection
             sf::View gameView = window.getView();
             mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -722,6 +859,7 @@ public:
             if (char1Frame.getGlobalBounds().contains(mousePos)) { clickedType = CharacterTypeID::KNIGHT; clicked = true; }
             else if (char2Frame.getGlobalBounds().contains(mousePos)) { clickedType = CharacterTypeID::ROGUE; clicked = true; }
             else if (char3Frame.getGlobalBounds().contains(mousePos)) { clickedType = CharacterTypeID::SAMURAI; clicked = true; }
+            else if (costumeText.getGlobalBounds().contains(mousePos)) cycleCostume(1);
 
             if (clicked) {
                 if (currentSelectionStep == 0) { // Player 1 selection
@@ -735,15 +873,21 @@ public:
                     if (gamePtr) {
                         gamePtr->selectedPlayer1Char = tempP1CharType;
                         gamePtr->selectedEnemyChar = tempP2CharType;
+                        gamePtr->selectedPlayer1Costume = tempCostumes[0];
+                        gamePtr->selectedEnemyCostume = tempCostumes[1];
                     }
                     nextState = GameStateID::MAP_SELECTION; // Proceed to map selection
                     wantsTransition = true;
                 }
             }
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Left) {
+            cycleCostume(-1);
+        } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Right) {
+            cycleCostume(1);
         } else if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape) {
             if (currentSelectionStep == 1) { // If selecting P2/AI, go back to P1 selection
-                onResize(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT, *m_playerRef, *m_enemyRef); // Pass current player/enemy references
                 currentSelectionStep = 0;
+                onResize(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT, *m_playerRef, *m_enemyRef); // Pass current player/enemy references
             } else { // If selecting P1, go back to mode selection
                 nextState = GameStateID::MODE_SELECTION;
                 wantsTransition = true;
@@ -752,12 +896,10 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr) override {
+        TRACE_SCOPE("CharacterSelectionScreen::update");
         // Store game mode for prompt text
         if (gamePtr) m_gameMode = gamePtr->currentMode;
 
-        // Transform mouse position to game coordinates for hover effect
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i
 
         // Apply hover and selection colors
         char1Frame.setFillColor(frameColor); // Reset colors first
@@ -795,13 +937,31 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(background.getTexture()) window.draw(background);
-        window.draw(promptText);
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(BG_FRAME_DELAY); // Only the background animation changes between inputs
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("CharacterSelectionScreen::draw");
+        if(background.getTexture()) RenderStats::draw(window, background);
+        RenderStats::draw(window, promptText);
+
+        RenderStats::draw(window, char1Frame); RenderStats::draw(window, char1TitleSprite); RenderStats::draw(window, char1NameText);
+        RenderStats::draw(window, char2Frame); RenderStats::draw(window, char2TitleSprite); RenderStats::draw(window, char2NameText);
+        RenderStats::draw(window, char3Frame); RenderStats::draw(window, char3TitleSprite); RenderStats::draw(window, char3NameText);
+        RenderStats::draw(window, costumeText);
+    }
+
+private:
+    void cycleCostume(int step) {
+        int& costume = tempCostumes[currentSelectionStep];
+        costume = (costume + step + COSTUME_COUNT) % COSTUME_COUNT;
+        refreshCostumeText();
+    }
 
-        window.draw(char1Frame); window.draw(char1TitleSprite); window.draw(char1NameText);
-        window.draw(char2Frame); window.draw(char2TitleSprite); window.draw(char2NameText);
-        window.draw(char3Frame); window.draw(char3TitleSprite); window.draw(char3NameText);
+    void refreshCostumeText() {
+        costumeText.setString(std::string("COSTUME:  < ") + Costumes[tempCostumes[currentSelectionStep]].name + " >");
+        Utils::centerOrigin(costumeText);
     }
 };
 
@@ -966,7 +1126,7 @@ public:
 
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
         if (event.type == sf::Event::MouseButtonPressed) {
-            sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+            sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
             // Transform mouse position to game coordinates for accurate hit detection
             sf::View gameView = window.getView();
             mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -989,9 +1149,7 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr = nullptr) override {
-        // Transform mouse position to game coordinates for hover effect
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i
+        TRACE_SCOPE("MapSelectionScreen::update");
 
         map1Frame.setFillColor(map1Frame.getGlobalBounds().contains(mousePos) ? mapFrameHoverColor : mapFrameColor);
         map2Frame.setFillColor(map2Frame.getGlobalBounds().contains(mousePos) ? mapFrameHoverColor : mapFrameColor);
@@ -1007,12 +1165,17 @@ public:
         }
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(background.getTexture()) window.draw(background);
-        window.draw(promptText);
-        window.draw(map1Frame); window.draw(map1PreviewSprite); window.draw(map1Text);
-        window.draw(map2Frame); window.draw(map2PreviewSprite); window.draw(map2Text);
-        window.draw(map3Frame); window.draw(map3PreviewSprite); window.draw(map3Text); // Draw Map 3 elements
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(BG_FRAME_DELAY); // Only the background animation changes between inputs
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("MapSelectionScreen::draw");
+        if(background.getTexture()) RenderStats::draw(window, background);
+        RenderStats::draw(window, promptText);
+        RenderStats::draw(window, map1Frame); RenderStats::draw(window, map1PreviewSprite); RenderStats::draw(window, map1Text);
+        RenderStats::draw(window, map2Frame); RenderStats::draw(window, map2PreviewSprite); RenderStats::draw(window, map2Text);
+        RenderStats::draw(window, map3Frame); RenderStats::draw(window, map3PreviewSprite); RenderStats::draw(window, map3Text); // Draw Map 3 elements
     }
 };
 
@@ -1021,113 +1184,59 @@ class GamePlayScreen : public Screen {
 public:
     Game* m_gamePtr;
 
-    sf::Text playerNameText_UI;
-    sf::RectangleShape playerUiPanel;
-    sf::RectangleShape playerHealthBarBg, playerHealthBar;
-
-    sf::Text enemyNameText_UI;
-    sf::RectangleShape enemyUiPanel;
-    sf::RectangleShape enemyHealthBarBg, enemyHealthBar;
-
-    sf::Sprite& gameBgSpriteRef;
+    // Render side (main thread only): drawn from RenderSnapshots, never from live fighters
+    HudBatch hud; // Panels, health bars, names and timer in retained vertex arrays
+    std::atomic<bool> hudLayoutDirty{true}; // Set by onResize, applied by the next drawSnapshot
+    RenderSnapshot liveSnapshot; // Scratch snapshot for draw() calls made under the simulation lock
 
     sf::RectangleShape playerAttackHitboxShape;
     sf::RectangleShape enemyAttackHitboxShape;
     sf::RectangleShape playerHurtboxShapeDebug; // For debugging hurtbox
     sf::RectangleShape enemyHurtboxShapeDebug; // For debugging hurtbox
+
+    // Simulation side
+    sf::Sprite& gameBgSpriteRef;
     bool showDebugHitboxes = false;
+    std::string hudNames[2]; // Names shown in the HUD panels, set on entry
 
     std::vector<DamageText> damageTexts;
+    char damageLabel[8]; // "-12" etc., formatted once instead of per hit
 
-    sf::Text timerText; // For game countdown
-    sf::Clock gameTimerClock;
+    SimClock gameTimerClock; // For game countdown (simulated time, so it stops while paused)
+    float remainingTime = GameConfig::GAME_ROUND_DURATION;
     bool timerEnded = false; // Flag to prevent repeated win/draw checks
 
     GamePlayScreen(sf::RenderWindow& window, Game* gamePtr, sf::Sprite& gameBgSprite)
         : m_gamePtr(gamePtr), gameBgSpriteRef(gameBgSprite) {
 
-        playerUiPanel.setSize(sf::Vector2f(340, 110));
-        playerUiPanel.setFillColor(sf::Color(20, 20, 30, 160));
-        playerUiPanel.setOutlineColor(sf::Color(100, 100, 120, 180));
-        playerUiPanel.setOutlineThickness(2);
-
-        playerHealthBarBg.setSize(sf::Vector2f(300, 30));
-        playerHealthBarBg.setFillColor(sf::Color(80, 0, 0, 200));
-        playerHealthBarBg.setOutlineColor(sf::Color::Black);
-        playerHealthBarBg.setOutlineThickness(1);
-
-        playerHealthBar.setSize(sf::Vector2f(300, 30));
-        playerHealthBar.setFillColor(sf::Color(0, 200, 0));
-
-        playerNameText_UI.setFont(ResourceManager::getFont("ariblk.ttf"));
-        playerNameText_UI.setCharacterSize(26);
-        playerNameText_UI.setFillColor(sf::Color(255, 215, 0)); // Golden fill
-        playerNameText_UI.setOutlineColor(sf::Color::Black);   // Black outline
-        playerNameText_UI.setOutlineThickness(2);              // Prominent outline
-
-
-        enemyUiPanel.setSize(sf::Vector2f(340, 110));
-        enemyUiPanel.setFillColor(sf::Color(30, 20, 20, 160));
-        enemyUiPanel.setOutlineColor(sf::Color(120, 100, 100, 180));
-        enemyUiPanel.setOutlineThickness(2);
-
-        enemyNameText_UI.setFont(ResourceManager::getFont("ariblk.ttf"));
-        enemyNameText_UI.setCharacterSize(26);
-        enemyNameText_UI.setFillColor(sf::Color(255, 215, 0)); // Golden fill
-        enemyNameText_UI.setOutlineColor(sf::Color::Black);   // Black outline
-        enemyNameText_UI.setOutlineThickness(2);              // Prominent outline
-
-        enemyHealthBarBg.setSize(sf::Vector2f(300, 30));
-        enemyHealthBarBg.setFillColor(sf::Color(80,0,0,200));
-        enemyHealthBarBg.setOutlineColor(sf::Color::Black);
-        enemyHealthBarBg.setOutlineThickness(1);
-
-        enemyHealthBar.setSize(sf::Vector2f(300,30));
-        enemyHealthBar.setFillColor(sf::Color(200,0,0));
+        hud.setFont(ResourceManager::getFont("ariblk.ttf"));
+        std::snprintf(damageLabel, sizeof(damageLabel), "-%d", static_cast<int>(GameConfig::ATTACK_DAMAGE));
 
         playerAttackHitboxShape.setFillColor(sf::Color(255,0,0,100));
         enemyAttackHitboxShape.setFillColor(sf::Color(0,0,255,100));
 
         playerHurtboxShapeDebug.setFillColor(sf::Color(0, 255, 0, 100)); // Green for hurtbox
         enemyHurtboxShapeDebug.setFillColor(sf::Color(0, 255, 0, 100)); // Green for hurtbox
-
-        // Timer Text Setup
-        timerText.setFont(ResourceManager::getFont("ariblk.ttf"));
-        timerText.setCharacterSize(40);
-        timerText.setFillColor(sf::Color(255, 215, 0)); // Gold color
-        timerText.setOutlineColor(sf::Color::Black);
-        timerText.setOutlineThickness(2);
-        Utils::centerOrigin(timerText);
     }
 
     void onEnter(const sf::RenderWindow& window, Player& playerRef, Enemy& enemyRef, const std::string& data) override {
         if (m_gamePtr) {
-            playerNameText_UI.setString(m_gamePtr->playerNameFromInput.empty() ? "Player 1" : m_gamePtr->playerNameFromInput);
-            if (m_gamePtr->currentMode == GameMode::PvP) {
-                enemyNameText_UI.setString(m_gamePtr->player2NameFromInput.empty() ? "Player 2" : m_gamePtr->player2NameFromInput);
-            } else {
-                enemyNameText_UI.setString("Rival");
-            }
+            hudNames[0] = m_gamePtr->playerNameFromInput.empty() ? "Player 1" : m_gamePtr->playerNameFromInput;
+            hudNames[1] = (m_gamePtr->currentMode == GameMode::PvP) ?
+                          (m_gamePtr->player2NameFromInput.empty() ? "Player 2" : m_gamePtr->player2NameFromInput) :
+                          "Rival";
         }
         damageTexts.clear();
+        damageTexts.reserve(RenderSnapshot::MAX_DAMAGE_TEXTS); // First hit of the match doesn't allocate
         gameTimerClock.restart(); // Start game timer
+        remainingTime = GameConfig::GAME_ROUND_DURATION;
         timerEnded = false; // Reset timer ended flag for a new game
         // Pass virtual resolution to onResize
         onResize(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT, playerRef, enemyRef);
     }
 
     void onResize(unsigned int width, unsigned int height, Player& playerRef, Enemy& enemyRef) override {
-    playerUiPanel.setPosition(15, 15);
-    playerHealthBarBg.setPosition(playerUiPanel.getPosition().x + 15, playerUiPanel.getPosition().y + 15);
-    playerHealthBar.setPosition(playerHealthBarBg.getPosition());
-    playerNameText_UI.setPosition(playerUiPanel.getPosition().x + 20, playerUiPanel.getPosition().y + playerHealthBarBg.getSize().y + 25);
-
-    enemyUiPanel.setPosition(width - enemyUiPanel.getSize().x - 15, 15);
-    enemyHealthBarBg.setPosition(enemyUiPanel.getPosition().x + 15, enemyUiPanel.getPosition().y + 15);
-    enemyHealthBar.setPosition(enemyHealthBarBg.getPosition());
-    enemyNameText_UI.setPosition(enemyUiPanel.getPosition().x + 20, enemyUiPanel.getPosition().y + enemyHealthBarBg.getSize().y + 25);
-
-    timerText.setPosition(width / 2.0f, 50.0f);
+    hudLayoutDirty = true; // The HUD belongs to the render thread; it re-lays itself out before its next draw
 
     float commonGroundY = height - (playerRef.frameHeight * playerRef.spriteScale) - 20;
     playerRef.setGroundY(commonGroundY);
@@ -1163,50 +1272,25 @@ public:
             if (event.key.code == sf::Keyboard::F1) {
                 showDebugHitboxes = !showDebugHitboxes;
             }
+            if (event.key.code == sf::Keyboard::F5) {
+                GameConfig::PIXEL_PRECISE_HITS = !GameConfig::PIXEL_PRECISE_HITS; // Shown on the F2 overlay
+            }
         }
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr) override {
+        TRACE_SCOPE("GamePlayScreen::update");
         if (timerEnded) return; // Stop game logic if timer ended and winner is determined by time
 
         playerRef.handleInput();
-        if (enemyRef.isPlayerControlled) {
-            enemyRef.handlePlayer2Input();
-        }
+        enemyRef.handlePlayer2Input(); // Player 2 or the AI
 
         playerRef.update(dt.asSeconds(), GameConfig::WINDOW_WIDTH, &enemyRef);
         enemyRef.update(dt.asSeconds(), GameConfig::WINDOW_WIDTH, &playerRef);
 
-        playerHealthBar.setSize(sf::Vector2f(playerHealthBarBg.getSize().x * Utils::clamp(playerRef.currentHealth / playerRef.maxHealth, 0.f, 1.f), playerHealthBarBg.getSize().y));
-        enemyHealthBar.setSize(sf::Vector2f(enemyHealthBarBg.getSize().x * Utils::clamp(enemyRef.currentHealth / enemyRef.maxHealth, 0.f, 1.f), enemyHealthBarBg.getSize().y));
-
-        // Player attack collision check
-        if (playerRef.isAttacking && !playerRef.dealtDamageThisAttack) {
-            sf::FloatRect playerHitbox = playerRef.getAttackHitbox();
-            // Use enemyRef.getHurtbox() for precise collision detection
-            if (enemyRef.isAlive && playerHitbox.intersects(enemyRef.getHurtbox())) {
-                enemyRef.takeDamage(GameConfig::ATTACK_DAMAGE);
-                playerRef.dealtDamageThisAttack = true;
-                sf::FloatRect targetBounds = enemyRef.sprite.getGlobalBounds(); // Use sprite bounds for text position
-                sf::Vector2f textPos(targetBounds.left + targetBounds.width / 2.f, targetBounds.top - 20.f);
-                damageTexts.emplace_back("-" + std::to_string(static_cast<int>(GameConfig::ATTACK_DAMAGE)), ResourceManager::getFont("ariblk.ttf"), 24, sf::Color::Yellow, textPos);
-                if(gamePtr) gamePtr->triggerScreenShake();
-            }
-        }
-
-        // Enemy attack collision check
-        if (enemyRef.isAttacking && !enemyRef.dealtDamageThisAttack) {
-            sf::FloatRect enemyHitbox = enemyRef.getAttackHitbox();
-             // Use playerRef.getHurtbox() for precise collision detection
-            if (playerRef.isAlive && enemyHitbox.intersects(playerRef.getHurtbox())) {
-                playerRef.takeDamage(GameConfig::ATTACK_DAMAGE);
-                enemyRef.dealtDamageThisAttack = true;
-                sf::FloatRect targetBounds = playerRef.sprite.getGlobalBounds(); // Use sprite bounds for text position
-                sf::Vector2f textPos(targetBounds.left + targetBounds.width / 2.f, targetBounds.top - 20.f);
-                damageTexts.emplace_back("-" + std::to_string(static_cast<int>(GameConfig::ATTACK_DAMAGE)), ResourceManager::getFont("ariblk.ttf"), 24, sf::Color::Red, textPos);
-                if(gamePtr) gamePtr->triggerScreenShake();
-            }
-        }
+        // Attack collision checks, player first
+        if (resolveAttack(playerRef, enemyRef, GameConfig::PIXEL_PRECISE_HITS)) onHit(enemyRef, sf::Color::Yellow, gamePtr);
+        if (resolveAttack(enemyRef, playerRef, GameConfig::PIXEL_PRECISE_HITS)) onHit(playerRef, sf::Color::Red, gamePtr);
 
         for (auto it = damageTexts.begin(); it != damageTexts.end(); ) {
             it->update(dt.asSeconds());
@@ -1217,26 +1301,6 @@ public:
             }
         }
 
-        if (showDebugHitboxes) {
-            playerAttackHitboxShape.setPosition(playerRef.getAttackHitbox().left, playerRef.getAttackHitbox().top);
-            playerAttackHitboxShape.setSize(sf::Vector2f(playerRef.getAttackHitbox().width, playerRef.getAttackHitbox().height));
-
-            enemyAttackHitboxShape.setPosition(enemyRef.getAttackHitbox().left, enemyRef.getAttackHitbox().top);
-            enemyAttackHitboxShape.setSize(sf::Vector2f(enemyRef.getAttackHitbox().width, enemyRef.getAttackHitbox().height));
-
-            playerHurtboxShapeDebug.setPosition(playerRef.getHurtbox().left, playerRef.getHurtbox().top);
-            playerHurtboxShapeDebug.setSize(sf::Vector2f(playerRef.getHurtbox().width, playerRef.getHurtbox().height));
-
-            enemyHurtboxShapeDebug.setPosition(enemyRef.getHurtbox().left, enemyRef.getHurtbox().top);
-            enemyHurtboxShapeDebug.setSize(sf::Vector2f(enemyRef.getHurtbox().width, enemyRef.getHurtbox().height));
-        }
-        else { // Hide debug shapes when not active
-            playerAttackHitboxShape.setSize(sf::Vector2f(0,0));
-            enemyAttackHitboxShape.setSize(sf::Vector2f(0,0));
-            playerHurtboxShapeDebug.setSize(sf::Vector2f(0,0));
-            enemyHurtboxShapeDebug.setSize(sf::Vector2f(0,0));
-        }
-
         // Check win conditions: KO first
         if (!playerRef.isAlive || !enemyRef.isAlive) {
             if (!timerEnded) { // Only trigger game over once from health depletion
@@ -1246,7 +1310,7 @@ public:
         }
 
         // Update timer
-        float remainingTime = GameConfig::GAME_ROUND_DURATION - gameTimerClock.getElapsedTime().asSeconds();
+        remainingTime = GameConfig::GAME_ROUND_DURATION - gameTimerClock.getElapsedTime().asSeconds();
         if (remainingTime <= 0.f) {
             remainingTime = 0.f; // Ensure time doesn't go negative for display
             if (!timerEnded) { // Timer ran out, determine winner by health
@@ -1260,39 +1324,130 @@ public:
                 timerEnded = true; // Set flag to prevent re-evaluation
             }
         }
-        timerText.setString(Utils::formatTime(remainingTime));
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
-        if(gameBgSpriteRef.getTexture()) window.draw(gameBgSpriteRef);
-        else window.clear(sf::Color::Cyan); // Debug color if map doesn't draw
+    // One fighter's attack against the other: damage lands once per swing, when the attack hitbox
+    // overlaps the defender's hurtbox. With `pixelPrecise` the overlap must also contain a pixel
+    // drawn by both fighters (their frame masks). Returns true if it hit.
+    static bool resolveAttack(Character& attacker, Character& defender, bool pixelPrecise = false) {
+        if (!attacker.isAttacking || attacker.dealtDamageThisAttack) return false;
+        // Use the defender's hurtbox for precise collision detection
+        sf::FloatRect overlap;
+        if (!defender.isAlive || !attacker.getAttackHitbox().intersects(defender.getHurtbox(), overlap)) return false;
+        if (pixelPrecise && !attacker.pixelsOverlap(defender, overlap)) return false;
+        defender.takeDamage(GameConfig::ATTACK_DAMAGE);
+        attacker.dealtDamageThisAttack = true;
+        return true;
+    }
+
+    // Damage number above the target, plus screen shake
+    void onHit(const Character& target, sf::Color textColor, Game* gamePtr) {
+        const sf::FloatRect& targetBounds = target.getBounds(); // Use sprite bounds for text position
+        sf::Vector2f textPos(targetBounds.left + targetBounds.width / 2.f, targetBounds.top - 20.f);
+        damageTexts.emplace_back(damageLabel, textColor, textPos);
+        if(gamePtr) gamePtr->triggerScreenShake();
+    }
 
-        playerRef.draw(window);
-        enemyRef.draw(window);
+    // Copies everything drawSnapshot needs out of the live match. Runs at the end of each tick on
+    // the simulation thread (and for draw() below), so it must not touch any render-side member.
+    void captureSnapshot(RenderSnapshot& snap, const Player& playerRef, const Enemy& enemyRef) const {
+        snap.hasBackground = gameBgSpriteRef.getTexture() != nullptr;
+        snap.background = gameBgSpriteRef;
+        snap.backgroundFrames = nullptr; // Game fills in the animation state and previous-tick values when publishing
+        const Character* fighters[2] = {&playerRef, &enemyRef};
+        for (int side = 0; side < 2; ++side) {
+            RenderSnapshot::FighterView& view = snap.fighters[side];
+            view.texture = fighters[side]->shownTexture();
+            view.palette = fighters[side]->paletteTexture();
+            view.costume = fighters[side]->costume;
+            view.position = fighters[side]->getPosition();
+            fighters[side]->frameQuad(view.quad);
+            snap.previousFighterPositions[side] = view.position;
+        }
 
-        window.draw(playerUiPanel);
-        window.draw(playerHealthBarBg);
-        window.draw(playerHealthBar);
-        window.draw(playerNameText_UI);
+        for (int side = 0; side < 2; ++side) {
+            std::strncpy(snap.names[side], hudNames[side].c_str(), sizeof(snap.names[side]) - 1);
+            snap.names[side][sizeof(snap.names[side]) - 1] = '\0';
+        }
+        snap.healthRatio[0] = playerRef.currentHealth / playerRef.maxHealth;
+        snap.healthRatio[1] = enemyRef.currentHealth / enemyRef.maxHealth;
+        snap.timerSeconds = static_cast<int>(remainingTime);
+
+        snap.damageTextCount = 0;
+        for (const auto& dmg : damageTexts) {
+            if (snap.damageTextCount == RenderSnapshot::MAX_DAMAGE_TEXTS) break;
+            RenderSnapshot::DamageTextView& view = snap.damageTexts[snap.damageTextCount++];
+            std::memcpy(view.label, dmg.label, sizeof(view.label));
+            view.position = dmg.position;
+            view.previousPosition = dmg.previousPosition;
+            view.color = dmg.color;
+        }
 
-        window.draw(enemyUiPanel);
-        window.draw(enemyHealthBarBg);
-        window.draw(enemyHealthBar);
-        window.draw(enemyNameText_UI);
+        snap.showDebugHitboxes = showDebugHitboxes;
+        snap.pixelPreciseHits = GameConfig::PIXEL_PRECISE_HITS;
+        if (showDebugHitboxes) {
+            snap.attackHitboxes[0] = playerRef.getAttackHitbox();
+            snap.attackHitboxes[1] = enemyRef.getAttackHitbox();
+            snap.hurtboxes[0] = playerRef.getHurtbox();
+            snap.hurtboxes[1] = enemyRef.getHurtbox();
+        }
+    }
 
-        window.draw(timerText); // Draw the timer
+    // Draws a match from a snapshot alone; used by the render thread while the simulation keeps running.
+    // `alpha` (see RenderSnapshot::interpolationAlpha) places the fighters, background animation and
+    // damage numbers between the previous tick and this one. The HUD panels opt out and show this tick.
+    void drawSnapshot(sf::RenderTarget& window, const RenderSnapshot& snap, float alpha = 1.f) {
+        TRACE_SCOPE("GamePlayScreen::drawSnapshot");
+        if (snap.hasBackground) {
+            sf::Sprite background = snap.background;
+            const std::vector<sf::Texture>* frames = snap.backgroundFrames;
+            if (frames && !frames->empty() && snap.backgroundFrameDelay > 0.f &&
+                snap.backgroundFrameTime + alpha * snap.tickLength.asSeconds() >= snap.backgroundFrameDelay) {
+                background.setTexture((*frames)[(snap.backgroundFrame + 1) % frames->size()]); // Frame flips before the next tick
+            }
+            RenderStats::draw(window, background);
+        }
+        else window.clear(sf::Color::Cyan); // Debug color if map doesn't draw
 
-        for (const auto& dt : damageTexts) {
-            window.draw(dt.text);
+        for (int side = 0; side < 2; ++side) {
+            const RenderSnapshot::FighterView& fighter = snap.fighters[side];
+            sf::RenderStates states(fighter.texture);
+            if (fighter.palette) states.shader = PaletteShader::prepare(*fighter.palette, fighter.costume);
+            states.transform.translate(Utils::lerp(snap.previousFighterPositions[side], fighter.position, alpha));
+            RenderStats::draw(window, fighter.quad, 4, sf::Quads, states);
         }
 
-        if (showDebugHitboxes) {
-            window.draw(playerAttackHitboxShape);
-            window.draw(enemyAttackHitboxShape);
-            window.draw(playerHurtboxShapeDebug);
-            window.draw(enemyHurtboxShapeDebug);
+        if (hudLayoutDirty.exchange(false)) hud.layout(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW_HEIGHT);
+        hud.setNames(snap.names[0], snap.names[1]);
+        hud.setHealth(snap.healthRatio[0], snap.healthRatio[1]);
+        hud.setTimerSeconds(snap.timerSeconds); // Re-laid out only when the displayed second changes
+        hud.setDamageTexts(snap.damageTexts, snap.damageTextCount, alpha);
+        hud.draw(window); // Panels and bars, then names, timer and damage numbers from the glyph atlas
+
+        if (snap.showDebugHitboxes) {
+            setDebugRect(playerAttackHitboxShape, snap.attackHitboxes[0]);
+            setDebugRect(enemyAttackHitboxShape, snap.attackHitboxes[1]);
+            setDebugRect(playerHurtboxShapeDebug, snap.hurtboxes[0]);
+            setDebugRect(enemyHurtboxShapeDebug, snap.hurtboxes[1]);
+            RenderStats::draw(window, playerAttackHitboxShape);
+            RenderStats::draw(window, enemyAttackHitboxShape);
+            RenderStats::draw(window, playerHurtboxShapeDebug);
+            RenderStats::draw(window, enemyHurtboxShapeDebug);
         }
     }
+
+    // Live draw (transitions, the pause capture): same path as the render thread, via a fresh snapshot
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("GamePlayScreen::draw");
+        captureSnapshot(liveSnapshot, playerRef, enemyRef);
+        drawSnapshot(window, liveSnapshot);
+    }
+
+private:
+    static void setDebugRect(sf::RectangleShape& shape, const sf::FloatRect& rect) {
+        shape.setPosition(rect.left, rect.top);
+        shape.setSize(sf::Vector2f(rect.width, rect.height));
+    }
 };
 
 // --- PauseScreen ---
@@ -1382,7 +1537,7 @@ public:
 
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
         if (event.type == sf::Event::MouseButtonPressed) {
-            sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+            sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
             // Mouse position needs to be transformed to game coordinates if view is letterboxed/pillarboxed
             sf::View gameView = window.getView();
             mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -1404,22 +1559,26 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr = nullptr) override {
+        TRACE_SCOPE("PauseScreen::update");
         // Mouse position needs to be transformed to game coordinates for hover effect
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i
 
         resumeButton.setFillColor(resumeButton.getGlobalBounds().contains(mousePos) ? resumeHoverColor : resumeColor);
         restartButton.setFillColor(restartButton.getGlobalBounds().contains(mousePos) ? restartHoverColor : restartColor);
         menuButtonShape.setFillColor(menuButtonShape.getGlobalBounds().contains(mousePos) ? menuBtnHoverColor : menuBtnColor);
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(0.5f); // Static menu over the cached match frame; hover redraws come from input
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("PauseScreen::draw");
         // Drawing is relative to the current view which is already set by Game::render
-        window.draw(overlay);
-        window.draw(pauseText);
-        window.draw(resumeButton); window.draw(resumeText);
-        window.draw(restartButton); window.draw(restartText);
-        window.draw(menuButtonShape); window.draw(menuText);
+        RenderStats::draw(window, overlay);
+        RenderStats::draw(window, pauseText);
+        RenderStats::draw(window, resumeButton); RenderStats::draw(window, resumeText);
+        RenderStats::draw(window, restartButton); RenderStats::draw(window, restartText);
+        RenderStats::draw(window, menuButtonShape); RenderStats::draw(window, menuText);
     }
 };
 
@@ -1538,7 +1697,7 @@ public:
 
     void handleEvent(sf::Event& event, sf::RenderWindow& window, GameStateID& nextState, bool& wantsTransition, GameStateID& gameResultState, Game* gamePtr) override {
          if (event.type == sf::Event::MouseButtonPressed) {
-             sf::Vector2f mousePos = sf::Vector2f(sf::Mouse::getPosition(window)); // Get mouse in pixel coords
+             sf::Vector2f mousePos(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y)); // Click position in pixel coords
              // Transform mouse position to game coordinates for accurate hit detection
              sf::View gameView = window.getView();
              mousePos = window.mapPixelToCoords(sf::Vector2i(mousePos), gameView);
@@ -1557,20 +1716,23 @@ public:
     }
 
     void update(sf::Time dt, sf::Vector2f mousePos, Player& playerRef, Enemy& enemyRef, GameStateID& gameResultState, Game* gamePtr = nullptr) override {
-        // Transform mouse position to game coordinates for hover effect
-        sf::View gameView = m_windowRef.getView();
-        mousePos = m_windowRef.mapPixelToCoords(sf::Vector2i(mousePos), gameView); // Ensure mousePos is sf::Vector2i
+        TRACE_SCOPE("GameOverScreen::update");
 
         restartButton.setFillColor(restartButton.getGlobalBounds().contains(mousePos) ? restartHoverColor : restartColor);
         menuButtonShape.setFillColor(menuButtonShape.getGlobalBounds().contains(mousePos) ? menuBtnHoverColor : menuBtnColor);
     }
 
-    void draw(sf::RenderWindow& window, const Player& playerRef, const Enemy& enemyRef) override {
+    sf::Time getIdleRedrawInterval() const override {
+        return sf::seconds(0.5f); // Static results screen
+    }
+
+    void draw(sf::RenderTarget& window, const Player& playerRef, const Enemy& enemyRef) override {
+        TRACE_SCOPE("GameOverScreen::draw");
         window.clear(sf::Color(30,10,10, 200)); // Clear with a semi-transparent dark red
-        window.draw(gameOverText);
-        window.draw(resultText);
-        window.draw(restartButton); window.draw(restartText);
-        window.draw(menuButtonShape); window.draw(menuText);
+        RenderStats::draw(window, gameOverText);
+        RenderStats::draw(window, resultText);
+        RenderStats::draw(window, restartButton); RenderStats::draw(window, restartText);
+        RenderStats::draw(window, menuButtonShape); RenderStats::draw(window, menuText);
     }
 };
 
@@ -1582,10 +1744,13 @@ Game::Game() : window(sf::VideoMode(GameConfig::WINDOW_WIDTH, GameConfig::WINDOW
     // GameConfig::WINDOW_WIDTH and GameConfig::WINDOW_HEIGHT are already set to 1280x720.
     // These are the virtual resolution that the game logic and UI are designed for.
     // The window is created with these dimensions initially and set to be resizable.
-    window.setFramerateLimit(GameConfig::FRAMERATE_LIMIT);
-    window.setVerticalSyncEnabled(true);
+    // No frame-rate cap by default: rendering follows the display's refresh (VSync) and
+    // interpolates between fixed simulation ticks, so a 144 Hz monitor gets 144 distinct frames.
+    // The pacer owns the VSync / limit settings so the two are never enabled together.
+    framePacer.apply(window);
 
     ResourceManager::getFont("ariblk.ttf"); // Pre-load a default font
+    perfOverlay.setFont(ResourceManager::getFont("ariblk.ttf"));
 
     screens[GameStateID::MENU] = std::make_unique<MenuScreen>(window);
     screens[GameStateID::NAME_INPUT] = std::make_unique<NameInputScreen>(window, playerNameFromInput, "PLAYER 1 ");
@@ -1630,79 +1795,271 @@ void Game::updateScreenShake(sf::Time dt) {
 
 
 void Game::run() {
+    // The simulation ticks on its own thread; this thread only polls window events and renders
+    Trace::setThreadName("Main (events + render)");
+    simulationRunning = true;
+    std::thread simulationThread(&Game::simulationLoop, this);
+
     while (window.isOpen()) {
-        sf::Time dt = gameClock.restart();
-        if (dt.asSeconds() > (1.0f / 20.0f)) { // Cap delta time to prevent physics glitches on lag spikes
-             dt = sf::seconds(1.0f / 60.0f);
+        {
+            sf::Time eventsStart = timeline.getElapsedTime();
+            TRACE_SCOPE("Game::processEvents");
+            std::lock_guard<std::mutex> lock(simMutex);
+            processEvents(); // Handle user input and window events
+            lastEventsTime = timeline.getElapsedTime() - eventsStart;
+        }
+        if (traceDumpRequested) {
+            traceDumpRequested = false;
+            startTraceDump();
         }
 
-        processEvents(); // Handle user input and window events
-        if (currentTransition == TransitionState::NONE) { // Only update game logic if not transitioning
-             update(dt * gameTimeScale);
+        // Nothing new since the last frame (idle menu, or the tick hasn't finished and the last
+        // frame already showed it fully): keep polling
+        std::uint64_t serial = frameSerial.load(std::memory_order_acquire);
+        if (serial == lastRenderedSerial && !renderInterpolating) {
+            sf::Time idleStart = timeline.getElapsedTime();
+            frameScheduler.idle();
+            idleSinceLastFrame += timeline.getElapsedTime() - idleStart;
+            continue;
         }
-        handleScreenTransition(dt); // Manage screen fade in/out
+        lastRenderedSerial = serial;
         render(); // Draw everything to the window
+    }
 
-        // Check for game over condition and trigger screen change
-        if (currentStateID == GameStateID::GAME_PLAY && gameResultState != GameStateID::GAME_PLAY) {
-            std::string outcomeMessage = "";
-            // Determine outcome message if GamePlayScreen set gameResultState to GAME_OVER due to timer
-            GamePlayScreen* gs = dynamic_cast<GamePlayScreen*>(screens[GameStateID::GAME_PLAY].get());
-            if (gs && gs->timerEnded) { // Check GamePlayScreen's timerEnded flag
-                if (player.currentHealth > enemy.currentHealth) {
-                    outcomeMessage = "P1_WON_BY_TIME";
-                } else if (enemy.currentHealth > player.currentHealth) {
-                    outcomeMessage = "P2_WON_BY_TIME";
-                } else {
-                    outcomeMessage = "DRAW_BY_TIME";
-                }
+    simulationRunning = false;
+    simulationThread.join();
+    if (consoleReport) {
+        framePacer.printLatency(std::cout);
+        aiBudget.print(std::cout);
+        AllocTracker::print(std::cout);
+    }
+    if (traceWriter.joinable()) traceWriter.join();
+    dumpTrace();
+}
+
+// F4: dumps the trace on a helper thread, like FlightRecorder's reports. A press while the last
+// dump is still being written is ignored rather than queued.
+void Game::startTraceDump() {
+    if (traceDumpRunning.exchange(true)) {
+        if (consoleReport) std::cout << "Trace dump already in progress" << std::endl;
+        return;
+    }
+    if (traceWriter.joinable()) traceWriter.join(); // Finished: traceDumpRunning was clear
+    traceWriter = std::thread([this]() {
+        dumpTrace();
+        traceDumpRunning = false;
+    });
+}
+
+// Writes the trace buffers next to the executable (F4, and on exit)
+void Game::dumpTrace() {
+    const char* path = "hellfire_trace.json";
+    if (!Trace::dump(path)) std::cerr << "Failed to write trace to " << path << std::endl;
+    else if (consoleReport) std::cout << "Trace written to " << path << " (open in chrome://tracing or ui.perfetto.dev)" << std::endl;
+}
+
+// Runs the simulation on a fixed tick (SIM_TICK), independent of how long rendering and presenting
+// take. Late ticks are caught up back to back, up to MAX_CATCHUP_TICKS.
+void Game::simulationLoop() {
+    Trace::setThreadName("Simulation");
+    sf::Time nextTick = timeline.getElapsedTime();
+
+    while (simulationRunning) {
+        sf::Time now = timeline.getElapsedTime();
+        if (now < nextTick) {
+            sf::sleep(nextTick - now);
+            continue;
+        }
+
+        for (int ticks = 0; now >= nextTick && ticks < MAX_CATCHUP_TICKS; ++ticks) {
+            {
+                std::lock_guard<std::mutex> lock(simMutex); // Released between ticks so the renderer can get in
+                simulationStep();
+            }
+            nextTick += SIM_TICK;
+        }
+        if (now >= nextTick) {
+            nextTick = now + SIM_TICK; // Fell too far behind (e.g. loading a map): drop the backlog
+        }
+    }
+}
+
+// One simulation tick. Called with simMutex held.
+void Game::simulationStep() {
+    if (!window.isOpen()) return; // Closed by the event thread; run() is about to join us
+
+    // Static screens are only advanced at their idle rate until input arrives
+    sf::Time idleInterval = screens[currentStateID]->getIdleRedrawInterval();
+    if (!frameScheduler.isFrameDue(idleInterval, currentTransition != TransitionState::NONE)) {
+        return;
+    }
+    TRACE_SCOPE("Game::simulationStep");
+    AllocTracker::Counters tickAllocStart = AllocTracker::thisThread();
+
+    sf::Time dt = gameClock.restart();
+    if (currentStateID == GameStateID::GAME_PLAY) { // Gameplay always steps by exactly one tick
+         dt = SIM_TICK;
+    } else if (dt.asSeconds() > 0.5f) { // Idle menus pass their real elapsed time, within reason
+         dt = sf::seconds(0.5f);
+    }
+
+    // Sample the fighters' controls once per tick, here rather than in the event loop, so input
+    // latency doesn't depend on how long the render thread is blocked presenting
+    if (driver) {
+        driver->sampleInput(player.input, enemy.input);
+    } else {
+        player.input = Input::sampleKeyboardP1();
+        enemy.input = enemy.isPlayerControlled ? Input::sampleKeyboardP2() : FighterInput();
+    }
+    if (enemyAI && !enemy.isPlayerControlled && currentStateID == GameStateID::GAME_PLAY &&
+        currentTransition == TransitionState::NONE) {
+        aiBudget.beginTick();
+        enemyAI->decide(enemy, player, enemy.input);
+        if (!driver) shadowRecording.record(player, enemy, player.input); // Scripted drivers aren't anyone's habits
+    }
+    inputSampledAt = timeline.getElapsedTime();
+
+    tickStartPositions[0] = player.getPosition();
+    tickStartPositions[1] = enemy.getPosition();
+
+    sf::Time phaseStart = timeline.getElapsedTime();
+    if (currentTransition == TransitionState::NONE) { // Only update game logic if not transitioning
+         update(dt * gameTimeScale);
+    }
+    sf::Time updateEnd = timeline.getElapsedTime();
+    handleScreenTransition(dt); // Manage screen fade in/out
+    checkGameOver();
+    lastUpdateTime = updateEnd - phaseStart;
+    lastTransitionTime = timeline.getElapsedTime() - updateEnd;
+
+    publishSnapshot();
+    frameScheduler.frameProduced();
+    frameSerial.fetch_add(1, std::memory_order_release);
+    lastTickAllocations = AllocTracker::since(tickAllocStart);
+}
+
+// Hands the renderer a copy of this tick. Menus are drawn live under the lock, so only gameplay is captured.
+void Game::publishSnapshot() {
+    TRACE_SCOPE("Game::publishSnapshot");
+    RenderSnapshot& snap = snapshots.writeSlot();
+    snap.valid = true;
+    snap.tick = ++simTick;
+    snap.publishedAt = timeline.getElapsedTime();
+    snap.tickLength = SIM_TICK;
+    snap.inputSampledAt = inputSampledAt;
+    snap.updateTime = lastUpdateTime;
+    snap.transitionTime = lastTransitionTime;
+    snap.tickAllocations = lastTickAllocations;
+    snap.state = currentStateID;
+    snap.transition = currentTransition;
+    snap.shakeOffset = isShaking ? shakeOffset : sf::Vector2f(0, 0);
+    snap.previousShakeOffset = lastPublishedShake;
+    lastPublishedShake = snap.shakeOffset;
+
+    if (currentStateID == GameStateID::GAME_PLAY || currentStateID == GameStateID::PAUSE) {
+        GamePlayScreen* gs = static_cast<GamePlayScreen*>(screens[GameStateID::GAME_PLAY].get());
+        gs->captureSnapshot(snap, player, enemy);
+        snap.previousFighterPositions[0] = tickStartPositions[0];
+        snap.previousFighterPositions[1] = tickStartPositions[1];
+
+        snap.backgroundFrames = currentGameBackgroundFrames;
+        snap.backgroundFrame = bgFrame;
+        snap.backgroundFrameTime = bgTimer;
+        snap.backgroundFrameDelay = (currentStateID == GameStateID::GAME_PLAY) ? MAP_FRAME_DELAY : 0.f; // Paused: no animation
+    }
+    snapshots.publish();
+}
+
+// Check for game over condition and trigger screen change
+void Game::checkGameOver() {
+    if (currentStateID == GameStateID::GAME_PLAY && gameResultState != GameStateID::GAME_PLAY) {
+        std::string outcomeMessage = "";
+        // Determine outcome message if GamePlayScreen set gameResultState to GAME_OVER due to timer
+        GamePlayScreen* gs = dynamic_cast<GamePlayScreen*>(screens[GameStateID::GAME_PLAY].get());
+        if (gs && gs->timerEnded) { // Check GamePlayScreen's timerEnded flag
+            if (player.currentHealth > enemy.currentHealth) {
+                outcomeMessage = "P1_WON_BY_TIME";
+            } else if (enemy.currentHealth > player.currentHealth) {
+                outcomeMessage = "P2_WON_BY_TIME";
+            } else {
+                outcomeMessage = "DRAW_BY_TIME";
             }
-            changeScreen(gameResultState, outcomeMessage); // Pass outcome message to changeScreen
         }
+        shadowTrainer.submit(player.name, std::move(shadowRecording.samples)); // Empty unless this was a recorded PvAI match
+        shadowRecording.samples.clear();
+        changeScreen(gameResultState, outcomeMessage); // Pass outcome message to changeScreen
     }
 }
 
+// Called with simMutex held
 void Game::processEvents() {
+    if (driver) {
+        injectedEvents.clear();
+        driver->injectEvents(injectedEvents);
+        for (sf::Event& injected : injectedEvents) handleEvent(injected);
+    }
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close(); // Close window when close button is clicked
-        }
-        if (event.type == sf::Event::Resized) {
-            // GameConfig::WINDOW_WIDTH and GameConfig::WINDOW_HEIGHT are the VIRTUAL resolution.
-            // They are NOT updated by the actual window resize event.
-            // The handleResize function should adapt the view to the new ACTUAL window size.
-            handleResize(event.size.width, event.size.height);
-        }
-
-        bool wantsTransition = false; // Flag to indicate if a screen change is requested
-        GameStateID potentialNextState = currentStateID; // Store potential next state
-
-        if (currentStateID == GameStateID::PAUSE) { // Special handling for pause state
-             screens[GameStateID::PAUSE]->handleEvent(event, window, potentialNextState, wantsTransition, gameResultState, this);
-             if (wantsTransition) { // If pause screen requests a state change (e.g., restart, main menu)
-                 changeScreen(potentialNextState);
-             } else if (potentialNextState == GameStateID::GAME_PLAY && currentStateID == GameStateID::PAUSE) {
-                 currentStateID = GameStateID::GAME_PLAY; // Resume game
-                 gameTimeScale = 1.0f; // Restore game time
-             }
-        } else if (currentTransition != TransitionState::FADING_OUT) { // Only handle events if not fading out
-            screens[currentStateID]->handleEvent(event, window, potentialNextState, wantsTransition, gameResultState, this);
-            if (potentialNextState == GameStateID::PAUSE && currentStateID == GameStateID::GAME_PLAY && !wantsTransition) {
-                currentStateID = GameStateID::PAUSE; // Pause game
-                gameTimeScale = 0.0f; // Stop game time
-                screens[GameStateID::PAUSE]->onEnter(window, player, enemy); // Call onEnter for pause screen
-            } else if (wantsTransition && currentTransition == TransitionState::NONE) {
-                changeScreen(potentialNextState); // Trigger screen change
-            }
+        handleEvent(event);
+    }
+}
+
+// One window (or injected) event. Called with simMutex held.
+void Game::handleEvent(sf::Event& event) {
+    frameScheduler.notifyInput(); // Any event brings the loop back to full rate
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2) {
+        perfOverlay.toggle();
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+        traceDumpRequested = true; // Written after the lock is released (run)
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+        if (consoleReport) framePacer.printLatency(std::cout); // Report the mode being left, then switch
+        framePacer.cycleMode(window); // The F2 overlay shows the new mode and its latency
+
+    }
+    if (event.type == sf::Event::Closed) {
+        window.close(); // Close window when close button is clicked
+    }
+    if (event.type == sf::Event::Resized) {
+        // GameConfig::WINDOW_WIDTH and GameConfig::WINDOW_HEIGHT are the VIRTUAL resolution.
+        // They are NOT updated by the actual window resize event.
+        // The handleResize function should adapt the view to the new ACTUAL window size.
+        handleResize(event.size.width, event.size.height);
+    }
+
+    bool wantsTransition = false; // Flag to indicate if a screen change is requested
+    GameStateID potentialNextState = currentStateID; // Store potential next state
+
+    if (currentStateID == GameStateID::PAUSE) { // Special handling for pause state
+         screens[GameStateID::PAUSE]->handleEvent(event, window, potentialNextState, wantsTransition, gameResultState, this);
+         if (wantsTransition) { // If pause screen requests a state change (e.g., restart, main menu)
+             changeScreen(potentialNextState);
+         } else if (potentialNextState == GameStateID::GAME_PLAY && currentStateID == GameStateID::PAUSE) {
+             currentStateID = GameStateID::GAME_PLAY; // Resume game
+             gameTimeScale = 1.0f; // Restore game time
+         }
+    } else if (currentTransition != TransitionState::FADING_OUT) { // Only handle events if not fading out
+        screens[currentStateID]->handleEvent(event, window, potentialNextState, wantsTransition, gameResultState, this);
+        if (potentialNextState == GameStateID::PAUSE && currentStateID == GameStateID::GAME_PLAY && !wantsTransition) {
+            currentStateID = GameStateID::PAUSE; // Pause game
+            gameTimeScale = 0.0f; // Stop game time
+            pauseFrameValid = false; // Capture the frozen match on the next render
+            screens[GameStateID::PAUSE]->onEnter(window, player, enemy); // Call onEnter for pause screen
+        } else if (wantsTransition && currentTransition == TransitionState::NONE) {
+            changeScreen(potentialNextState); // Trigger screen change
         }
     }
 }
 
 void Game::update(sf::Time dt) {
+    TRACE_SCOPE("Game::update");
+    SimClock::advance(dt); // Gameplay timers run on simulated time (dt is already time-scaled, so pause freezes them)
+
     // Mouse position needs to be transformed to game coordinates
-    // This assumes the current view is the game's logical view (1280x720 scaled by Game::handleResize)
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window), window.getView());
+    // gameView is the game's logical view (1280x720 scaled by Game::handleResize); the window's own
+    // view is left to the render thread, which moves it around for screen shake
+    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window), gameView);
 
     updateScreenShake(dt); // Update screen shake effect
 
@@ -1727,35 +2084,161 @@ void Game::update(sf::Time dt) {
 }
 
 void Game::render() {
+    TRACE_SCOPE("Game::render");
+    {
+        TRACE_SCOPE("FramePacer::waitForLatch");
+        framePacer.waitForLatch(timeline); // Late latch: start the frame just in time for the next vblank
+    }
+    sf::Time renderStart = timeline.getElapsedTime();
+    sf::Time frameInputTime; // Input timestamp of what this frame shows (gameplay only)
+    RenderStats::beginFrame();
+
     window.clear(sf::Color::Black); // Clear to black for letterboxing/pillarboxing
 
     // Get the base view setup by handleResize (for aspect ratio)
     sf::View currentWindowView = window.getView();
     sf::View gameContentOnlyView = currentWindowView; // Copy this view for game content
 
-    // Apply screen shake to the game content view if active during gameplay
-    if (isShaking && currentStateID == GameStateID::GAME_PLAY) {
-        gameContentOnlyView.move(shakeOffset);
-    }
-    window.setView(gameContentOnlyView); // Set view for drawing game elements
+    bool freshTick = snapshots.acquire(); // Pick up the newest tick, if one was published since the last frame
+    const RenderSnapshot& snap = snapshots.readSlot();
+
+    renderInterpolating = false;
+    if (snap.valid && snap.state == GameStateID::GAME_PLAY && snap.transition == TransitionState::NONE) {
+        // Live gameplay is drawn from the snapshot alone, so the next tick runs meanwhile. Motion is
+        // interpolated from the previous tick to this one, which keeps it smooth at any refresh rate.
+        float alpha = snap.interpolationAlpha(timeline.getElapsedTime());
+        renderInterpolating = alpha < 1.f;
+        frameInputTime = snap.inputSampledAt;
+
+        std::lock_guard<std::mutex> assetLock(assetMutex);
+        gameContentOnlyView.move(Utils::lerp(snap.previousShakeOffset, snap.shakeOffset, alpha)); // Zero unless the screen is shaking
+        window.setView(gameContentOnlyView);
+        static_cast<GamePlayScreen*>(screens[GameStateID::GAME_PLAY].get())->drawSnapshot(window, snap, alpha);
+        window.setView(currentWindowView);
+    } else {
+        // Menus, pause and transitions draw the live screens; they are cheap, so the tick just waits
+        std::lock_guard<std::mutex> lock(simMutex);
 
-    // Draw the current active screen (or GamePlayScreen if paused)
-    if (currentStateID == GameStateID::PAUSE) {
-        if(screens.count(GameStateID::GAME_PLAY)) {
-            screens[GameStateID::GAME_PLAY]->draw(window, player, enemy); // Draw underlying game state
+        // Apply screen shake to the game content view if active during gameplay
+        if (isShaking && currentStateID == GameStateID::GAME_PLAY) {
+            gameContentOnlyView.move(shakeOffset);
         }
-        screens[GameStateID::PAUSE]->draw(window, player, enemy); // Draw pause menu on top
-    } else {
-        screens[currentStateID]->draw(window, player, enemy);
+        window.setView(gameContentOnlyView); // Set view for drawing game elements
+
+        // Draw the current active screen (or the frozen GamePlayScreen frame if paused)
+        if (currentStateID == GameStateID::PAUSE) {
+            // Nothing moves while paused, so the match is rendered once into pauseFrame and reused
+            if (pauseFrameValid || capturePauseFrame()) {
+                RenderStats::draw(window, pauseFrameSprite);
+            } else if (screens.count(GameStateID::GAME_PLAY)) {
+                screens[GameStateID::GAME_PLAY]->draw(window, player, enemy); // Fallback: draw underlying game state live
+            }
+            screens[GameStateID::PAUSE]->draw(window, player, enemy); // Draw pause menu on top
+        } else {
+            screens[currentStateID]->draw(window, player, enemy);
+        }
+
+        window.setView(currentWindowView); // Revert to the non-shaking view for transitionRect to cover the whole window
+
+        // Draw transition rectangle if a transition is active
+        if (currentTransition != TransitionState::NONE) {
+            RenderStats::draw(window, transitionRect);
+        }
+    }
+    if (perfOverlay.visible) {
+        char pacingLine[96];
+        std::snprintf(pacingLine, sizeof(pacingLine), "pacing %s   latency %.1f ms   hits %s",
+                      framePacer.modeName(), framePacer.latency.average().asMicroseconds() / 1000.f,
+                      snap.pixelPreciseHits ? "pixel" : "AABB");
+        perfOverlay.draw(window, timeline, pacingLine);
+    }
+    sf::Time renderTime = timeline.getElapsedTime() - renderStart;
+
+    sf::Time gpuTime;
+    if (measureGpuTime) {
+        TRACE_SCOPE("Game::waitForGpu");
+        sf::Time gpuStart = timeline.getElapsedTime();
+        glFinish(); // Everything queued for this frame has executed once this returns
+        gpuTime = timeline.getElapsedTime() - gpuStart;
     }
 
-    window.setView(currentWindowView); // Revert to the non-shaking view for transitionRect to cover the whole window
+    {
+        TRACE_SCOPE("Game::present");
+        framePacer.waitForPresent(timeline); // Limiter: hold the frame until its deadline
+        window.display(); // Display rendered frame (outside the locks: this may block on VSync)
+    }
+    framePacer.framePresented(timeline, frameInputTime);
+
+    sf::Time presentedAt = timeline.getElapsedTime();
+    PerfOverlay::Sample sample;
+    sample.frame = presentedAt - lastPresentAt;
+    sample.events = lastEventsTime;
+    sample.update = snap.updateTime;
+    sample.transition = snap.transitionTime;
+    sample.render = renderTime;
+    sample.gpu = gpuTime;
+    sample.frameAllocations = AllocTracker::since(frameAllocStart);
+    sample.tickAllocations = snap.tickAllocations;
+    perfOverlay.recordFrame(sample);
+    if (driver) driver->framePresented(sample);
+    recordFlight(snap, sample, freshTick);
+    lastPresentAt = presentedAt;
+    idleSinceLastFrame = sf::Time::Zero;
+    frameAllocStart = AllocTracker::thisThread();
+}
 
-    // Draw transition rectangle if a transition is active
-    if (currentTransition != TransitionState::NONE) {
-        window.draw(transitionRect);
+// Feeds the always-on flight recorder and writes a hitch report when a frame or tick runs long
+void Game::recordFlight(const RenderSnapshot& snap, const PerfOverlay::Sample& sample, bool freshTick) {
+    auto ms = [](sf::Time t) { return t.asMicroseconds() / 1000.f; };
+
+    FlightRecorder::FrameRecord record;
+    record.timeUs = FlightRecorder::nowUs();
+    record.frameMs = ms(sample.frame);
+    record.eventsMs = ms(sample.events);
+    record.updateMs = ms(sample.update);
+    record.transitionMs = ms(sample.transition);
+    record.renderMs = ms(sample.render);
+    record.drawCalls = RenderStats::currentFrame().drawCalls;
+    record.state = snap.state;
+    record.transition = snap.transition;
+    record.backgroundFrame = snap.backgroundFrame;
+
+    FlightRecorder& recorder = FlightRecorder::global();
+    recorder.recordFrame(record);
+
+    if (lastPresentAt > sf::Time::Zero) {
+        // During a match or a fade every frame is expected; on idle menus the renderer waits on purpose
+        bool expectsEveryFrame = snap.state == GameStateID::GAME_PLAY || snap.transition != TransitionState::NONE;
+        sf::Time frameTime = expectsEveryFrame ? sample.frame : sample.frame - idleSinceLastFrame;
+        recorder.checkHitch("frame", ms(frameTime));
     }
-    window.display(); // Display rendered frame
+    if (freshTick) recorder.checkHitch("simulation tick", ms(sample.update + sample.transition));
+}
+
+// Renders the paused match into pauseFrame at the on-screen resolution of the game viewport
+bool Game::capturePauseFrame() {
+    TRACE_SCOPE("Game::capturePauseFrame");
+    if (!screens.count(GameStateID::GAME_PLAY)) return false;
+
+    sf::IntRect viewportPixels = window.getViewport(window.getView());
+    unsigned int width = static_cast<unsigned int>(std::max(1, viewportPixels.width));
+    unsigned int height = static_cast<unsigned int>(std::max(1, viewportPixels.height));
+    if (pauseFrame.getSize() != sf::Vector2u(width, height) && !pauseFrame.create(width, height)) {
+        std::cerr << "Failed to create pause frame texture; drawing the paused match live." << std::endl;
+        return false;
+    }
+
+    pauseFrame.setView(sf::View(sf::FloatRect(0, 0, static_cast<float>(GameConfig::WINDOW_WIDTH), static_cast<float>(GameConfig::WINDOW_HEIGHT))));
+    pauseFrame.clear(sf::Color::Black);
+    screens[GameStateID::GAME_PLAY]->draw(pauseFrame, player, enemy);
+    pauseFrame.display();
+
+    pauseFrameSprite.setTexture(pauseFrame.getTexture(), true);
+    ResourceManager::trackTexture(pauseFrame.getTexture());
+    pauseFrameSprite.setScale(static_cast<float>(GameConfig::WINDOW_WIDTH) / width, static_cast<float>(GameConfig::WINDOW_HEIGHT) / height);
+    pauseFrameSprite.setPosition(0, 0);
+    pauseFrameValid = true;
+    return true;
 }
 
 // Triggers a screen transition
@@ -1774,6 +2257,7 @@ void Game::changeScreen(GameStateID newStateID, const std::string& onEnterData /
 
 // Handles the fade in/out effect during screen transitions
 void Game::handleScreenTransition(sf::Time dt) {
+    TRACE_SCOPE("Game::handleScreenTransition");
     if (currentTransition == TransitionState::NONE) {
         // Ensure gameTimeScale is correct when no transition is active
         gameTimeScale = (currentStateID == GameStateID::PAUSE || currentStateID == GameStateID::GAME_OVER) ? 0.0f : 1.0f;
@@ -1793,9 +2277,18 @@ void Game::handleScreenTransition(sf::Time dt) {
 
             // Special handling for GAME_PLAY state entry
             if (currentStateID == GameStateID::GAME_PLAY) {
+                // The render thread may still be drawing an older snapshot that points at these textures
+                std::lock_guard<std::mutex> assetLock(assetMutex);
+                TRACE_SCOPE("Load match assets");
+
                 // Load selected character assets for player and enemy
                 player.loadCharacterAssets(selectedPlayer1Char);
                 enemy.loadCharacterAssets(selectedEnemyChar);
+                player.costume = selectedPlayer1Costume;
+                enemy.costume = selectedEnemyCostume;
+                if (selectedEnemyChar == selectedPlayer1Char && enemy.costume == player.costume) {
+                    enemy.costume = (player.costume + 1) % COSTUME_COUNT; // Mirror match: tell them apart
+                }
 
                 player.name = playerNameFromInput.empty() ? "Player 1" : playerNameFromInput;
                 player.reset(); // Reset player state
@@ -1806,6 +2299,31 @@ void Game::handleScreenTransition(sf::Time dt) {
                                  (player2NameFromInput.empty() ? "Player 2" : player2NameFromInput) :
                                  "Rival"; // Set enemy name
                 enemy.reset(); // Reset enemy state (no xPos param)
+                if (enemy.isPlayerControlled) {
+                    enemyAI.reset();
+                } else if (aiDifficulty == AIDifficulty::EXPERT) {
+                    enemyAI.reset(new SearchAI(aiProfile(aiDifficulty), &aiBudget));
+                } else if (aiDifficulty == AIDifficulty::TABLE &&
+                           (policyTable.isLoaded() || policyTable.load(GameConfig::AI_POLICY_PATH))) {
+                    enemyAI.reset(new TableAI(&policyTable, aiProfile(aiDifficulty), &aiBudget));
+                } else if (aiDifficulty == AIDifficulty::TABLE) {
+                    std::cerr << "No usable policy table at " << GameConfig::AI_POLICY_PATH << "; Hard AI plays instead" << std::endl;
+                    enemyAI.reset(new UtilityAI(aiProfile(AIDifficulty::HARD), &aiBudget));
+                } else if (aiDifficulty == AIDifficulty::SHADOW && !shadowTrainer.model(player.name)->empty()) {
+                    enemyAI.reset(new ShadowAI(shadowTrainer.model(player.name), aiProfile(aiDifficulty), &aiBudget));
+                } else if (aiDifficulty == AIDifficulty::SHADOW) {
+                    std::cerr << "No habits recorded for " << player.name << " yet; Hard AI plays instead" << std::endl;
+                    enemyAI.reset(new UtilityAI(aiProfile(AIDifficulty::HARD), &aiBudget));
+                } else if (aiDifficulty == AIDifficulty::BOT &&
+                           (botLink.isOpen() || botLink.create(GameConfig::BOT_LINK_NAME, 1))) {
+                    enemyAI.reset(new BotAI(&botLink));
+                } else if (aiDifficulty == AIDifficulty::BOT) {
+                    std::cerr << "Bot link unavailable (" << botLink.error() << "); Hard AI plays instead" << std::endl;
+                    enemyAI.reset(new UtilityAI(aiProfile(AIDifficulty::HARD), &aiBudget));
+                } else {
+                    enemyAI.reset(new UtilityAI(aiProfile(aiDifficulty), &aiBudget));
+                }
+                shadowRecording.begin(); // Every PvAI match teaches the Shadow, whoever is playing it
                 enemy.resetPosition(GameConfig::WINDOW_WIDTH * 0.75f); // Set enemy start position
 
                 // Set common ground Y for both characters
@@ -1845,9 +2363,10 @@ void Game::handleScreenTransition(sf::Time dt) {
             }
             // Call onEnter for the new screen state.
             // The `onEnterData` parameter to `changeScreen` is passed here.
+            // onEnter lays the screen out at the virtual resolution; the window's view is unchanged by a
+            // state change and belongs to the main thread, so handleResize isn't needed here.
             screens[currentStateID]->onEnter(window, player, enemy, onEnterDataForNextScreen); // This still needs to be correctly populated if Game::run passes data.
                                                                                               // For now, rely on Game::run logic directly setting the outcome string.
-            handleResize(window.getSize().x, window.getSize().y);
 
             currentTransition = TransitionState::FADING_IN; // Start fade-in
             transitionClock.restart();
@@ -1906,6 +2425,7 @@ void Game::handleResize(unsigned int width, unsigned int height) {
 
     newView.setViewport(viewport); // Apply the calculated viewport
     window.setView(newView); // Set the window's view
+    gameView = newView; // Copy for mouse mapping on the simulation thread
 
     // Transition rectangle needs to cover the entire physical window, not just the scaled viewport
     transitionRect.setSize(sf::Vector2f(actualWidth, actualHeight));
@@ -1919,4 +2439,5 @@ void Game::handleResize(unsigned int width, unsigned int height) {
     if (currentStateID == GameStateID::PAUSE && screens.count(GameStateID::GAME_PLAY) && screens[GameStateID::GAME_PLAY]) {
         screens[GameStateID::GAME_PLAY]->onResize(virtualWidth, virtualHeight, player, enemy);
     }
+    pauseFrameValid = false; // Re-capture at the new viewport resolution
 }
\ No newline at end of file
@@ -6,6 +6,7 @@ namespace GameConfig {
     unsigned int WINDOW_WIDTH = 1280;
     unsigned int WINDOW_HEIGHT = 720;
     const unsigned int FRAMERATE_LIMIT = 60;
+    const unsigned int SIMULATION_TICK_RATE = 60; // Fixed gameplay ticks per second; rendering interpolates between them
     const unsigned int MAX_NAME_LENGTH = 15;
     const float RUN_BOOST_MULTIPLIER = 1.30f;
     const float TRANSITION_DURATION = 0.35f;
@@ -24,4 +25,28 @@ namespace GameConfig {
     const float SCREEN_SHAKE_DURATION = 0.15f;
 
     const float GAME_ROUND_DURATION = 120.0f; // 2 minutes (120 seconds)
+
+    // Pixel-precise hits (F5 in a match): a hit also needs the fighters' drawn pixels to touch.
+    // Toggled and read under Game::simMutex; FighterSim::capture copies it into the MatchState so
+    // the AIs' look-ahead plays by the same rule.
+    bool PIXEL_PRECISE_HITS = false;
+
+    // Wall-clock time all AI fighters together may spend deciding per simulation tick
+    const float AI_TICK_BUDGET_US = 250.0f;
+    // Expert AI look-ahead: wall-clock deadline per search and worker threads (0 picks from the core count).
+    // Size the deadline per hardware tier from the nodes/s printed on exit (--report).
+    const float SEARCH_AI_BUDGET_MS = 6.0f;
+    const int SEARCH_AI_THREADS = 0;
+    // Policy table for the "Table" difficulty, written by policy_compile
+    const char* const AI_POLICY_PATH = "assets/ai_policy.bin";
+    // Shadow AI: per-player habit files are this prefix + name + ".bin"; a round's worth of ticks is reserved for recording
+    const char* const SHADOW_PROFILE_PREFIX = "shadow_";
+    const int SHADOW_RESERVE_TICKS = static_cast<int>(GAME_ROUND_DURATION * SIMULATION_TICK_RATE);
+    // Shared-memory segment an external bot attaches to when the "Bot" difficulty is picked
+    const char* const BOT_LINK_NAME = "/hellfire_bot";
+
+    // Flight recorder: a frame or tick longer than this writes a hitch report
+    const float HITCH_BUDGET_MS = 33.0f;
+    const float HITCH_HISTORY_SECONDS = 5.0f;  // How much history each report covers
+    const float HITCH_REPORT_COOLDOWN = 10.0f; // Minimum seconds between reports (loading screens hitch in bursts)
 }
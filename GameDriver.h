@@ -0,0 +1,23 @@
+#pragma once
+#include <vector>
+#include <SFML/Window.hpp>
+#include "Input.h"
+#include "PerfOverlay.h"
+
+// --- Game Driver ---
+// Stands in for the person at the keyboard. When Game::driver is set, the events it injects are
+// handled exactly like window events and the fighter controls it returns replace the keyboard
+// sample, so a run can be scripted and a match replayed tick for tick (see e2e.cpp).
+class GameDriver {
+public:
+    virtual ~GameDriver() = default;
+
+    // Render thread, with simMutex held, before the window is polled. Append events to inject.
+    virtual void injectEvents(std::vector<sf::Event>& events) = 0;
+
+    // Simulation thread, with simMutex held, once per tick in place of the keyboard sample
+    virtual void sampleInput(FighterInput& player1, FighterInput& player2) = 0;
+
+    // Render thread, after each present
+    virtual void framePresented(const PerfOverlay::Sample& sample) {}
+};
@@ -0,0 +1,215 @@
+#pragma once
+#include <vector>
+#include <iostream>
+#include <SFML/Graphics.hpp>
+#include "RenderStats.h"
+
+// --- Glyph Atlas ---
+// Pre-rasterizes printable ASCII for a handful of (size, outline) styles into one texture.
+// The outline is baked under the fill (fill white, outline black), so a character is a single
+// quad and the vertex color tints the fill while the outline stays black. Layout reads fixed
+// per-style tables and writes into caller-owned vertices, so it never allocates.
+class GlyphAtlas {
+public:
+    static constexpr sf::Uint32 FIRST_CHAR = 32;  // ' '
+    static constexpr sf::Uint32 LAST_CHAR = 126;  // '~'
+    static constexpr unsigned int ATLAS_WIDTH = 1024;
+
+    struct BakedGlyph {
+        sf::FloatRect bounds;  // Quad relative to the pen on the baseline
+        sf::FloatRect texRect; // Cell in the atlas texture
+        float advance = 0.f;
+    };
+
+    struct Style {
+        unsigned int charSize = 0;
+        float outlineThickness = 0.f;
+        BakedGlyph glyphs[LAST_CHAR - FIRST_CHAR + 1];
+    };
+
+    // Registers a style to bake; returns its id for layout calls. Call before build().
+    int addStyle(unsigned int charSize, float outlineThickness) {
+        Style style;
+        style.charSize = charSize;
+        style.outlineThickness = outlineThickness;
+        styles.push_back(style);
+        return static_cast<int>(styles.size()) - 1;
+    }
+
+    // Rasterizes every registered style from `sourceFont` and uploads the atlas texture
+    bool build(const sf::Font& sourceFont) {
+        font = &sourceFont;
+        const unsigned int padding = 2;
+
+        // Request every glyph first so each size's font page is complete before it is read back
+        struct SourceGlyphs { sf::Glyph fill[LAST_CHAR - FIRST_CHAR + 1], outline[LAST_CHAR - FIRST_CHAR + 1]; };
+        std::vector<SourceGlyphs> sources(styles.size());
+        for (std::size_t s = 0; s < styles.size(); ++s) {
+            for (sf::Uint32 c = FIRST_CHAR; c <= LAST_CHAR; ++c) {
+                sources[s].fill[c - FIRST_CHAR] = font->getGlyph(c, styles[s].charSize, false);
+                sources[s].outline[c - FIRST_CHAR] = styles[s].outlineThickness > 0.f ?
+                    font->getGlyph(c, styles[s].charSize, false, styles[s].outlineThickness) :
+                    sources[s].fill[c - FIRST_CHAR];
+            }
+        }
+
+        // Shelf-pack the cells (outline rect is the larger of the two)
+        std::vector<sf::Vector2u> cellPos(styles.size() * (LAST_CHAR - FIRST_CHAR + 1));
+        unsigned int penX = padding, penY = padding, shelfHeight = 0;
+        for (std::size_t s = 0; s < styles.size(); ++s) {
+            for (sf::Uint32 i = 0; i <= LAST_CHAR - FIRST_CHAR; ++i) {
+                const sf::IntRect& r = sources[s].outline[i].textureRect;
+                if (penX + r.width + padding > ATLAS_WIDTH) {
+                    penX = padding;
+                    penY += shelfHeight + padding;
+                    shelfHeight = 0;
+                }
+                cellPos[s * (LAST_CHAR - FIRST_CHAR + 1) + i] = sf::Vector2u(penX, penY);
+                penX += r.width + padding;
+                shelfHeight = std::max(shelfHeight, static_cast<unsigned int>(r.height));
+            }
+        }
+        unsigned int atlasHeight = penY + shelfHeight + padding;
+
+        sf::Image atlasImage;
+        atlasImage.create(ATLAS_WIDTH, atlasHeight, sf::Color(255, 255, 255, 0));
+
+        for (std::size_t s = 0; s < styles.size(); ++s) {
+            sf::Image page = font->getTexture(styles[s].charSize).copyToImage();
+            for (sf::Uint32 i = 0; i <= LAST_CHAR - FIRST_CHAR; ++i) {
+                const sf::Glyph& fill = sources[s].fill[i];
+                const sf::Glyph& outline = sources[s].outline[i];
+                sf::Vector2u cell = cellPos[s * (LAST_CHAR - FIRST_CHAR + 1) + i];
+
+                bakeGlyph(atlasImage, cell, page, fill, outline, styles[s].outlineThickness > 0.f);
+
+                BakedGlyph& baked = styles[s].glyphs[i];
+                baked.bounds = outline.bounds;
+                baked.texRect = sf::FloatRect(static_cast<float>(cell.x), static_cast<float>(cell.y),
+                                              static_cast<float>(outline.textureRect.width), static_cast<float>(outline.textureRect.height));
+                baked.advance = fill.advance;
+            }
+        }
+
+        if (!texture.loadFromImage(atlasImage)) {
+            std::cerr << "Failed to create glyph atlas texture" << std::endl;
+            return false;
+        }
+        texture.setSmooth(true);
+        return true;
+    }
+
+    const sf::Texture& getTexture() const { return texture; }
+    const Style& getStyle(int style) const { return styles[style]; }
+
+    // Writes one quad per visible character of `str` into `out` (at most `maxVertices`).
+    // `pos` is the top-left of the text's local space, like sf::Text::setPosition; the baseline
+    // sits at pos.y + charSize. Returns the number of vertices written.
+    std::size_t layout(sf::Vertex* out, std::size_t maxVertices, int styleId, const char* str,
+                       sf::Vector2f pos, sf::Color color) const {
+        const Style& style = styles[styleId];
+        float x = pos.x;
+        float baseline = pos.y + static_cast<float>(style.charSize);
+        std::size_t written = 0;
+        sf::Uint32 prevChar = 0;
+
+        for (const char* p = str; *p; ++p) {
+            sf::Uint32 c = static_cast<unsigned char>(*p);
+            if (c < FIRST_CHAR || c > LAST_CHAR) c = '?';
+            if (font) x += font->getKerning(prevChar, c, style.charSize);
+            prevChar = c;
+
+            const BakedGlyph& glyph = style.glyphs[c - FIRST_CHAR];
+            if (c != ' ' && glyph.texRect.width > 0 && written + 4 <= maxVertices) {
+                float left = x + glyph.bounds.left, top = baseline + glyph.bounds.top;
+                float right = left + glyph.bounds.width, bottom = top + glyph.bounds.height;
+                float u1 = glyph.texRect.left, v1 = glyph.texRect.top;
+                float u2 = u1 + glyph.texRect.width, v2 = v1 + glyph.texRect.height;
+
+                out[written++] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+                out[written++] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+                out[written++] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+                out[written++] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+            }
+            x += glyph.advance;
+        }
+        return written;
+    }
+
+private:
+    const sf::Font* font = nullptr;
+    std::vector<Style> styles;
+    sf::Texture texture;
+
+    // Composites the fill glyph (white) over the outline glyph (black) into the atlas cell
+    static void bakeGlyph(sf::Image& atlas, sf::Vector2u cell, const sf::Image& page,
+                          const sf::Glyph& fill, const sf::Glyph& outline, bool hasOutline) {
+        int offsetX = static_cast<int>(fill.bounds.left - outline.bounds.left + 0.5f);
+        int offsetY = static_cast<int>(fill.bounds.top - outline.bounds.top + 0.5f);
+
+        for (int y = 0; y < outline.textureRect.height; ++y) {
+            for (int x = 0; x < outline.textureRect.width; ++x) {
+                float outlineAlpha = 0.f;
+                if (hasOutline) {
+                    outlineAlpha = page.getPixel(outline.textureRect.left + x, outline.textureRect.top + y).a / 255.f;
+                }
+                float fillAlpha = 0.f;
+                int fx = x - offsetX, fy = y - offsetY;
+                if (fx >= 0 && fy >= 0 && fx < fill.textureRect.width && fy < fill.textureRect.height) {
+                    fillAlpha = page.getPixel(fill.textureRect.left + fx, fill.textureRect.top + fy).a / 255.f;
+                }
+
+                // "Fill over outline": white with coverage fillAlpha on top of black with outlineAlpha
+                float alpha = fillAlpha + outlineAlpha * (1.f - fillAlpha);
+                sf::Uint8 shade = alpha > 0.f ? static_cast<sf::Uint8>(255.f * fillAlpha / alpha) : 255;
+                atlas.setPixel(cell.x + x, cell.y + y, sf::Color(shade, shade, shade, static_cast<sf::Uint8>(alpha * 255.f)));
+            }
+        }
+    }
+};
+
+// --- Text Batch ---
+// Fixed-capacity quad buffer for atlas text. Clearing and re-filling it never allocates.
+class TextBatch {
+public:
+    explicit TextBatch(std::size_t maxGlyphs = 64) : vertices(maxGlyphs * 4) {}
+
+    void clear() { count = 0; }
+    void truncate(std::size_t vertexCount) { count = std::min(count, vertexCount); }
+    std::size_t size() const { return count; }
+
+    // Appends `str` and returns the local bounds of what was added
+    sf::FloatRect append(const GlyphAtlas& atlas, int style, const char* str, sf::Vector2f pos, sf::Color color) {
+        std::size_t first = count;
+        count += atlas.layout(vertices.data() + count, vertices.size() - count, style, str, pos, color);
+        return boundsOf(first, count);
+    }
+
+    // Appends `str` centered on `center` (the same result as Utils::centerOrigin on an sf::Text)
+    void appendCentered(const GlyphAtlas& atlas, int style, const char* str, sf::Vector2f center, sf::Color color) {
+        std::size_t first = count;
+        sf::FloatRect bounds = append(atlas, style, str, sf::Vector2f(0, 0), color);
+        sf::Vector2f offset(center.x - (bounds.left + bounds.width / 2.0f), center.y - (bounds.top + bounds.height / 2.0f));
+        for (std::size_t i = first; i < count; ++i) {
+            vertices[i].position += offset;
+        }
+    }
+
+    void draw(sf::RenderTarget& target, const GlyphAtlas& atlas) const {
+        if (count > 0) RenderStats::draw(target, vertices.data(), count, sf::Quads, sf::RenderStates(&atlas.getTexture()));
+    }
+
+private:
+    std::vector<sf::Vertex> vertices;
+    std::size_t count = 0;
+
+    sf::FloatRect boundsOf(std::size_t first, std::size_t last) const {
+        if (first >= last) return sf::FloatRect();
+        float minX = vertices[first].position.x, maxX = minX, minY = vertices[first].position.y, maxY = minY;
+        for (std::size_t i = first; i < last; ++i) {
+            minX = std::min(minX, vertices[i].position.x); maxX = std::max(maxX, vertices[i].position.x);
+            minY = std::min(minY, vertices[i].position.y); maxY = std::max(maxY, vertices[i].position.y);
+        }
+        return sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+};
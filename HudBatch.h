@@ -0,0 +1,172 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "RenderStats.h"
+#include "Utils.h"
+#include "GlyphAtlas.h"
+#include "ResourceManager.h"
+#include "RenderSnapshot.h"
+
+// --- HUD Batch ---
+// Retained geometry for the gameplay HUD. Panels, health-bar backgrounds and bars live in a
+// single quad array; names, the timer and damage numbers share one text batch laid out from a
+// glyph atlas. Nothing is rebuilt unless the value it shows changes, so a frame costs two draw
+// calls: one for the shapes and one for all HUD text.
+class HudBatch {
+public:
+    // Layout and look of the two fighter panels
+    const sf::Vector2f PANEL_SIZE = sf::Vector2f(340, 110);
+    const sf::Vector2f BAR_SIZE = sf::Vector2f(300, 30);
+    const float PANEL_MARGIN = 15.0f;
+    const unsigned int NAME_CHAR_SIZE = 26;
+    const unsigned int TIMER_CHAR_SIZE = 40;
+    const unsigned int DAMAGE_CHAR_SIZE = 24;
+    const float TEXT_OUTLINE = 2.0f;
+
+    HudBatch() : shapes(sf::Quads), text(128) {}
+
+    // Bakes the glyphs the HUD uses (names, digits, damage numbers) into the atlas
+    void setFont(const sf::Font& hudFont) {
+        nameStyle = atlas.addStyle(NAME_CHAR_SIZE, TEXT_OUTLINE);
+        timerStyle = atlas.addStyle(TIMER_CHAR_SIZE, TEXT_OUTLINE);
+        damageStyle = atlas.addStyle(DAMAGE_CHAR_SIZE, 0.f);
+        atlasReady = atlas.build(hudFont);
+        ResourceManager::trackTexture(atlas.getTexture());
+    }
+
+    // Rebuilds every quad for the given virtual resolution
+    void layout(unsigned int width, unsigned int height) {
+        shapes.clear();
+
+        sf::Vector2f panelPos[2] = {
+            sf::Vector2f(PANEL_MARGIN, PANEL_MARGIN),
+            sf::Vector2f(width - PANEL_SIZE.x - PANEL_MARGIN, PANEL_MARGIN)
+        };
+        sf::Color panelFill[2] = { sf::Color(20, 20, 30, 160), sf::Color(30, 20, 20, 160) };
+        sf::Color panelOutline[2] = { sf::Color(100, 100, 120, 180), sf::Color(120, 100, 100, 180) };
+
+        for (int side = 0; side < 2; ++side) {
+            sf::FloatRect panel(panelPos[side], PANEL_SIZE);
+            appendRect(panel, panelFill[side]);
+            appendFrame(panel, 2.0f, panelOutline[side]);
+
+            barRect[side] = sf::FloatRect(panel.left + 15, panel.top + 15, BAR_SIZE.x, BAR_SIZE.y);
+            appendRect(barRect[side], sf::Color(80, 0, 0, 200));
+            appendFrame(barRect[side], 1.0f, sf::Color::Black);
+
+            barQuad[side] = shapes.getVertexCount();
+            appendRect(barRect[side], side == 0 ? sf::Color(0, 200, 0) : sf::Color(200, 0, 0));
+
+            namePos[side] = sf::Vector2f(panel.left + 20, panel.top + BAR_SIZE.y + 25);
+        }
+        timerPos = sf::Vector2f(width / 2.0f, 50.0f);
+
+        // Re-apply the current values to the fresh geometry
+        float ratios[2] = { healthRatio[0], healthRatio[1] };
+        healthRatio[0] = healthRatio[1] = -1.f;
+        setHealth(ratios[0], ratios[1]);
+        rebuildText();
+    }
+
+    void setNames(const char* playerName, const char* enemyName) {
+        if (playerName == names[0] && enemyName == names[1]) return;
+        names[0] = playerName;
+        names[1] = enemyName;
+        rebuildText();
+    }
+
+    // Ratios are clamped to [0, 1]; only the bar quads are touched, and only on change
+    void setHealth(float playerRatio, float enemyRatio) {
+        float ratios[2] = { Utils::clamp(playerRatio, 0.f, 1.f), Utils::clamp(enemyRatio, 0.f, 1.f) };
+        for (int side = 0; side < 2; ++side) {
+            if (ratios[side] == healthRatio[side]) continue;
+            healthRatio[side] = ratios[side];
+            if (barQuad[side] + 4 > shapes.getVertexCount()) continue; // Not laid out yet
+
+            float right = barRect[side].left + barRect[side].width * ratios[side];
+            shapes[barQuad[side] + 1].position.x = right;
+            shapes[barQuad[side] + 2].position.x = right;
+        }
+    }
+
+    void setTimerSeconds(int seconds) {
+        if (seconds == timerSeconds) return;
+        timerSeconds = seconds;
+        rebuildTimer();
+    }
+
+    // Damage numbers move every frame, so their quads are re-laid out each frame (no allocation).
+    // They are world effects and follow the interpolation factor; the panels, bars and timer opt
+    // out and always show the latest tick.
+    void setDamageTexts(const RenderSnapshot::DamageTextView* damageTexts, int count, float alpha = 1.f) {
+        if (!atlasReady) return;
+        if (count == 0 && text.size() == timerEnd) return;
+        text.truncate(timerEnd);
+        for (int i = 0; i < count; ++i) {
+            sf::Vector2f center = Utils::lerp(damageTexts[i].previousPosition, damageTexts[i].position, alpha);
+            text.appendCentered(atlas, damageStyle, damageTexts[i].label, center, damageTexts[i].color);
+        }
+    }
+
+    void draw(sf::RenderTarget& target) const {
+        RenderStats::draw(target, shapes);
+        text.draw(target, atlas);
+    }
+
+private:
+    GlyphAtlas atlas;
+    bool atlasReady = false;
+    int nameStyle = 0, timerStyle = 0, damageStyle = 0;
+
+    sf::VertexArray shapes;
+    TextBatch text;         // [names][timer][damage numbers]
+    std::size_t namesEnd = 0, timerEnd = 0;
+
+    sf::FloatRect barRect[2];
+    std::size_t barQuad[2] = { 0, 0 };
+    float healthRatio[2] = { 1.f, 1.f };
+    sf::Vector2f namePos[2];
+    sf::Vector2f timerPos;
+    std::string names[2];
+    int timerSeconds = -1;
+
+    void appendRect(const sf::FloatRect& rect, sf::Color color) {
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color));
+    }
+
+    // Outline drawn outside the rectangle, the same way sf::Shape extrudes its outline
+    void appendFrame(const sf::FloatRect& rect, float thickness, sf::Color color) {
+        float l = rect.left - thickness, t = rect.top - thickness;
+        float r = rect.left + rect.width + thickness, b = rect.top + rect.height + thickness;
+        appendRect(sf::FloatRect(l, t, r - l, thickness), color);                        // Top
+        appendRect(sf::FloatRect(l, b - thickness, r - l, thickness), color);            // Bottom
+        appendRect(sf::FloatRect(l, rect.top, thickness, rect.height), color);           // Left
+        appendRect(sf::FloatRect(r - thickness, rect.top, thickness, rect.height), color); // Right
+    }
+
+    void rebuildText() {
+        text.clear();
+        if (atlasReady) {
+            text.append(atlas, nameStyle, names[0].c_str(), namePos[0], sf::Color(255, 215, 0));
+            text.append(atlas, nameStyle, names[1].c_str(), namePos[1], sf::Color(255, 215, 0));
+        }
+        namesEnd = text.size();
+        rebuildTimer();
+    }
+
+    // Drops the timer and damage quads and lays the timer out again; damage numbers are
+    // re-appended by the next setDamageTexts call
+    void rebuildTimer() {
+        text.truncate(namesEnd);
+        if (atlasReady && timerSeconds >= 0) {
+            char timeLabel[16];
+            Utils::formatTime(static_cast<float>(timerSeconds), timeLabel, sizeof(timeLabel));
+            text.appendCentered(atlas, timerStyle, timeLabel, timerPos, sf::Color(255, 215, 0));
+        }
+        timerEnd = text.size();
+    }
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <SFML/Window.hpp>
+
+// --- Fighter Input ---
+// One simulation tick's worth of controls for a fighter. The simulation samples the keyboard
+// into these once per tick, and fighters read them instead of querying sf::Keyboard directly,
+// so the same code path can later be driven by replays or AI.
+struct FighterInput {
+    enum Button : std::uint16_t {
+        LEFT    = 1 << 0,
+        RIGHT   = 1 << 1,
+        JUMP    = 1 << 2,
+        RUN     = 1 << 3,
+        SHIELD  = 1 << 4,
+        ATTACK1 = 1 << 5,
+        ATTACK2 = 1 << 6,
+        ATTACK3 = 1 << 7
+    };
+
+    std::uint16_t buttons = 0;
+
+    bool has(Button button) const { return (buttons & button) != 0; }
+    void set(Button button, bool down) {
+        if (down) buttons |= button;
+        else buttons &= static_cast<std::uint16_t>(~button);
+    }
+};
+
+namespace Input {
+    // Player 1: A/D move, W jump, LShift run, T shield, F/G/H attacks
+    FighterInput sampleKeyboardP1() {
+        FighterInput in;
+        in.set(FighterInput::LEFT, sf::Keyboard::isKeyPressed(sf::Keyboard::A));
+        in.set(FighterInput::RIGHT, sf::Keyboard::isKeyPressed(sf::Keyboard::D));
+        in.set(FighterInput::JUMP, sf::Keyboard::isKeyPressed(sf::Keyboard::W));
+        in.set(FighterInput::RUN, sf::Keyboard::isKeyPressed(sf::Keyboard::LShift));
+        in.set(FighterInput::SHIELD, sf::Keyboard::isKeyPressed(sf::Keyboard::T));
+        in.set(FighterInput::ATTACK1, sf::Keyboard::isKeyPressed(sf::Keyboard::F));
+        in.set(FighterInput::ATTACK2, sf::Keyboard::isKeyPressed(sf::Keyboard::G));
+        in.set(FighterInput::ATTACK3, sf::Keyboard::isKeyPressed(sf::Keyboard::H));
+        return in;
+    }
+
+    // Player 2: arrow keys move, Up jump, RShift run, Numpad0 shield, Numpad1-3 attacks
+    FighterInput sampleKeyboardP2() {
+        FighterInput in;
+        in.set(FighterInput::LEFT, sf::Keyboard::isKeyPressed(sf::Keyboard::Left));
+        in.set(FighterInput::RIGHT, sf::Keyboard::isKeyPressed(sf::Keyboard::Right));
+        in.set(FighterInput::JUMP, sf::Keyboard::isKeyPressed(sf::Keyboard::Up));
+        in.set(FighterInput::RUN, sf::Keyboard::isKeyPressed(sf::Keyboard::RShift));
+        in.set(FighterInput::SHIELD, sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad0));
+        in.set(FighterInput::ATTACK1, sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad1));
+        in.set(FighterInput::ATTACK2, sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad2));
+        in.set(FighterInput::ATTACK3, sf::Keyboard::isKeyPressed(sf::Keyboard::Numpad3));
+        return in;
+    }
+}
@@ -0,0 +1,347 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "FighterAI.h"
+#include "FighterSim.h"
+#include "GameConfig.h"
+#include "SearchAI.h"
+#include "Trace.h"
+
+// --- Match Env ---
+// K independent headless matches stepped in lockstep, for training Enemy controllers offline:
+//
+//   MatchEnv env(1024);                           // K = 1024, one worker per core
+//   env.seed(42);                                 // env i draws from seed 42 + i
+//   const float* obs = env.reset();               // K * MatchEnv::OBS_SIZE floats
+//   MatchEnv::StepResult r = env.step(actions);   // actions[K], each an AIOption index
+//   // r.observations[K * OBS_SIZE], r.rewards[K], r.dones[K]
+//
+// The learner plays the enemy side (FighterSim index 1); the player side is a scripted opponent
+// chosen in MatchEnvConfig. Matches run on FighterSim with models read straight from the presets,
+// so nothing needs a window or GL context. Observations, rewards and dones live in contiguous
+// buffers owned by the env and are overwritten by the next step.
+//
+// An env whose match ends (KO or round timeout) resets itself inside step(): its done flag is set,
+// its reward covers the final step, and its observation is already the first one of the next match.
+// Each env has its own RNG, so a run is reproducible for a given seed whatever the thread count.
+
+enum class EnvOpponent { IDLE, RANDOM, GREEDY };
+
+struct MatchEnvConfig {
+    CharacterTypeID learnerCharacter = CharacterTypeID::ROGUE;
+    CharacterTypeID opponentCharacter = CharacterTypeID::KNIGHT;
+    bool randomCharacters = false; // Draw both characters from the env's RNG at every reset
+    EnvOpponent opponent = EnvOpponent::GREEDY;
+    int ticksPerStep = 1;          // Each action is held for this many simulation ticks
+    float roundSeconds = GameConfig::GAME_ROUND_DURATION;
+    float spawnJitter = 0.f;       // Start positions vary by up to this many pixels either way
+    int threads = 0;               // 0: one per core
+};
+
+class MatchEnv {
+public:
+    // Observation layout, all from the learner's side and roughly in [-1, 1]
+    enum Observation {
+        OBS_DX,               // Opponent hurtbox centre minus ours, in window widths
+        OBS_DY,               // Same vertically, in window heights
+        OBS_X,                // Our position across the stage (walls matter for retreating)
+        OBS_HEALTH,
+        OBS_OPPONENT_HEALTH,
+        OBS_CAN_ATTACK,
+        OBS_OPPONENT_CAN_ATTACK,
+        OBS_FACING_OPPONENT,
+        OBS_JUMPING,
+        OBS_ATTACKING,
+        OBS_SHIELDING,
+        OBS_HURT,
+        OBS_VELOCITY_Y,
+        OBS_OPPONENT_FACING_US,
+        OBS_OPPONENT_JUMPING,
+        OBS_OPPONENT_ATTACKING,
+        OBS_OPPONENT_SHIELDING,
+        OBS_OPPONENT_HURT,
+        OBS_OPPONENT_VELOCITY_Y,
+        OBS_TIME_LEFT,        // 1 at the start of the round, 0 at the timeout
+        OBS_OPPONENT_ACTION,  // One-hot over Character::Action, ACTION_COUNT floats
+        OBS_SIZE = OBS_OPPONENT_ACTION + ACTION_COUNT
+    };
+
+    static const int ACTION_SIZE = AI_OPTION_COUNT; // Actions are AIOption indices
+
+    // Values of `dones`
+    static const std::uint8_t RUNNING = 0;
+    static const std::uint8_t KNOCKOUT = 1; // Terminal
+    static const std::uint8_t TIMEOUT = 2;  // Truncated: the round clock ran out
+
+    struct StepResult {
+        const float* observations; // [K * OBS_SIZE]
+        const float* rewards;      // [K]
+        const std::uint8_t* dones; // [K]
+    };
+
+    MatchEnvConfig config;
+    std::atomic<std::uint64_t> episodes{0}; // Matches finished across all envs
+
+    MatchEnv(int count, const MatchEnvConfig& envConfig = MatchEnvConfig(), std::uint64_t seedValue = 0)
+        : config(envConfig), envs(count), observations(static_cast<std::size_t>(count) * OBS_SIZE),
+          rewards(count), dones(count) {
+        if (config.randomCharacters) {
+            for (const auto& preset : AllCharacterPresets) models[preset.first] = FighterModel::fromPreset(preset.first);
+        } else {
+            models[config.learnerCharacter] = FighterModel::fromPreset(config.learnerCharacter);
+            models[config.opponentCharacter] = FighterModel::fromPreset(config.opponentCharacter);
+        }
+        roundTicks = std::max(1, static_cast<int>(config.roundSeconds * GameConfig::SIMULATION_TICK_RATE));
+        seed(seedValue);
+
+        int threads = config.threads;
+        if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+        threads = std::max(1, std::min(threads, count));
+        for (int i = 1; i < threads; ++i) workers.emplace_back(&MatchEnv::workerLoop, this, i, threads);
+        chunks = threads;
+    }
+
+    ~MatchEnv() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    MatchEnv(const MatchEnv&) = delete;
+    MatchEnv& operator=(const MatchEnv&) = delete;
+
+    int size() const { return static_cast<int>(envs.size()); }
+    int threadCount() const { return chunks; } // Workers plus the calling thread
+
+    // Env i draws from base + i. Takes effect at each env's next reset.
+    void seed(std::uint64_t base) {
+        for (int i = 0; i < size(); ++i) seed(i, base + static_cast<std::uint64_t>(i));
+    }
+
+    void seed(int env, std::uint64_t value) { envs[env].rng.seed(value); }
+
+    // Starts a fresh match in every env; returns the first observations
+    const float* reset() {
+        for (int i = 0; i < size(); ++i) {
+            resetEnv(i);
+            rewards[i] = 0.f;
+            dones[i] = RUNNING;
+        }
+        return observations.data();
+    }
+
+    // Advances every env by config.ticksPerStep ticks with actions[i] held by env i's learner.
+    // Blocks until all of them are done; the envs are split across the workers in equal chunks.
+    StepResult step(const int* actions) {
+        TRACE_SCOPE("MatchEnv::step");
+        pendingActions = actions;
+        if (!workers.empty()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running.store(static_cast<int>(workers.size()));
+                ++generation;
+            }
+            wake.notify_all();
+        }
+        stepChunk(0, chunks);
+        if (!workers.empty()) {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return running.load() == 0; });
+        }
+        return {observations.data(), rewards.data(), dones.data()};
+    }
+
+    // The observation `side` gets of `match`, OBS_SIZE floats into `out`. Public so other hosts
+    // of a learned controller (BotLink, the live game) feed it exactly what training did.
+    static void writeObservation(const MatchState& match, int side, float timeLeft, float* out) {
+        const FighterState& me = match.fighters[side];
+        const FighterState& them = match.fighters[1 - side];
+        float dx = SearchAI::offset(match, side);
+        sf::FloatRect mine = me.hurtbox(match.models[side]);
+        sf::FloatRect theirs = them.hurtbox(match.models[1 - side]);
+        float width = static_cast<float>(GameConfig::WINDOW_WIDTH);
+        float height = static_cast<float>(GameConfig::WINDOW_HEIGHT);
+
+        float* o = out;
+        std::fill(o, o + OBS_SIZE, 0.f);
+        o[OBS_DX] = dx / width;
+        o[OBS_DY] = ((theirs.top + theirs.height / 2.f) - (mine.top + mine.height / 2.f)) / height;
+        o[OBS_X] = (mine.left + mine.width / 2.f) / width;
+        o[OBS_HEALTH] = me.health / GameConfig::MAX_HEALTH;
+        o[OBS_OPPONENT_HEALTH] = them.health / GameConfig::MAX_HEALTH;
+        o[OBS_CAN_ATTACK] = me.canAttack ? 1.f : 0.f;
+        o[OBS_OPPONENT_CAN_ATTACK] = them.canAttack ? 1.f : 0.f;
+        o[OBS_FACING_OPPONENT] = me.facingRight == (dx >= 0.f) ? 1.f : 0.f;
+        o[OBS_JUMPING] = me.jumping ? 1.f : 0.f;
+        o[OBS_ATTACKING] = me.attacking ? 1.f : 0.f;
+        o[OBS_SHIELDING] = me.shielding ? 1.f : 0.f;
+        o[OBS_HURT] = me.hurt ? 1.f : 0.f;
+        o[OBS_VELOCITY_Y] = me.verticalVelocity / -GameConfig::JUMP_STRENGTH;
+        o[OBS_OPPONENT_FACING_US] = them.facingRight == (dx < 0.f) ? 1.f : 0.f;
+        o[OBS_OPPONENT_JUMPING] = them.jumping ? 1.f : 0.f;
+        o[OBS_OPPONENT_ATTACKING] = them.attacking ? 1.f : 0.f;
+        o[OBS_OPPONENT_SHIELDING] = them.shielding ? 1.f : 0.f;
+        o[OBS_OPPONENT_HURT] = them.hurt ? 1.f : 0.f;
+        o[OBS_OPPONENT_VELOCITY_Y] = them.verticalVelocity / -GameConfig::JUMP_STRENGTH;
+        o[OBS_TIME_LEFT] = timeLeft;
+        o[OBS_OPPONENT_ACTION + static_cast<int>(them.action)] = 1.f;
+    }
+
+    const MatchState& state(int env) const { return envs[env].match; }
+    const float* observation(int env) const { return observations.data() + static_cast<std::size_t>(env) * OBS_SIZE; }
+
+private:
+    // Everything one env owns, on its own cache lines so neighbouring workers don't share them
+    struct alignas(64) Env {
+        MatchState match;
+        std::mt19937_64 rng;
+        AIOption held[2] = {AIOption::IDLE, AIOption::IDLE};
+        int ticks = 0;
+        int opponentHoldTicks = 0; // RANDOM opponent: ticks left on its current option
+    };
+
+    std::vector<Env> envs;
+    std::map<CharacterTypeID, FighterModel> models;
+    int roundTicks = 0;
+
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<std::uint8_t> dones;
+
+    std::vector<std::thread> workers;
+    int chunks = 1;
+    const int* pendingActions = nullptr;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::atomic<int> running{0};
+    std::uint64_t generation = 0;
+    bool stopping = false;
+
+    void workerLoop(int chunk, int chunkCount) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            stepChunk(chunk, chunkCount);
+            if (running.fetch_sub(1) == 1) { // Last one out wakes step()
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    void stepChunk(int chunk, int chunkCount) {
+        int begin = static_cast<int>(static_cast<long long>(size()) * chunk / chunkCount);
+        int end = static_cast<int>(static_cast<long long>(size()) * (chunk + 1) / chunkCount);
+        for (int i = begin; i < end; ++i) stepEnv(i, pendingActions[i]);
+    }
+
+    void stepEnv(int i, int action) {
+        Env& env = envs[i];
+        MatchState& match = env.match;
+        float healthBefore = match.fighters[1].health;
+        float opponentHealthBefore = match.fighters[0].health;
+
+        env.held[1] = static_cast<AIOption>(std::min(std::max(action, 0), ACTION_SIZE - 1));
+        const float dt = 1.0f / GameConfig::SIMULATION_TICK_RATE;
+        std::uint8_t outcome = RUNNING;
+        for (int t = 0; t < config.ticksPerStep && outcome == RUNNING; ++t) {
+            FighterInput inputs[2];
+            for (int side = 0; side < 2; ++side) {
+                if (side == 0) env.held[0] = opponentOption(env);
+                float dx = SearchAI::offset(match, side);
+                pressOption(env.held[side], dx, match.fighters[side].facingRight == (dx >= 0.f), inputs[side]);
+            }
+            FighterSim::step(match, inputs[0], inputs[1], dt);
+            ++env.ticks;
+            if (!match.fighters[0].alive || !match.fighters[1].alive) outcome = KNOCKOUT;
+            else if (env.ticks >= roundTicks) outcome = TIMEOUT;
+        }
+
+        // Damage dealt minus damage taken, plus the result of a knockout
+        float reward = ((opponentHealthBefore - match.fighters[0].health) - (healthBefore - match.fighters[1].health)) / GameConfig::MAX_HEALTH;
+        if (outcome == KNOCKOUT) {
+            if (!match.fighters[0].alive) reward += 1.f;
+            if (!match.fighters[1].alive) reward -= 1.f;
+        }
+        rewards[i] = reward;
+        dones[i] = outcome;
+
+        if (outcome != RUNNING) {
+            episodes.fetch_add(1, std::memory_order_relaxed);
+            resetEnv(i);
+        } else {
+            observe(i);
+        }
+    }
+
+    // The scripted player side, re-decided every tick (GREEDY) or every few ticks (RANDOM)
+    AIOption opponentOption(Env& env) {
+        switch (config.opponent) {
+            case EnvOpponent::IDLE:
+                return AIOption::IDLE;
+            case EnvOpponent::GREEDY:
+                return SearchAI::greedy(env.match, 0);
+            case EnvOpponent::RANDOM:
+                if (--env.opponentHoldTicks > 0) return env.held[0];
+                env.opponentHoldTicks = SearchAI::HOLD_TICKS;
+                return static_cast<AIOption>(std::uniform_int_distribution<int>(0, AI_OPTION_COUNT - 1)(env.rng));
+        }
+        return AIOption::IDLE;
+    }
+
+    void resetEnv(int i) {
+        Env& env = envs[i];
+        CharacterTypeID learner = config.learnerCharacter;
+        CharacterTypeID opponent = config.opponentCharacter;
+        if (config.randomCharacters) {
+            std::uniform_int_distribution<int> pick(0, static_cast<int>(models.size()) - 1);
+            learner = std::next(models.begin(), pick(env.rng))->first;
+            opponent = std::next(models.begin(), pick(env.rng))->first;
+        }
+
+        MatchState& match = env.match;
+        match.models[0] = models[opponent];
+        match.models[1] = models[learner];
+        // GamePlayScreen grounds both fighters from the player's frame height
+        float groundY = GameConfig::WINDOW_HEIGHT - (match.models[0].frameHeight * match.models[0].scale) - 20;
+        match.models[0].groundY = groundY;
+        match.models[1].groundY = groundY;
+
+        float jitter[2] = {0.f, 0.f};
+        if (config.spawnJitter > 0.f) {
+            std::uniform_real_distribution<float> spread(-config.spawnJitter, config.spawnJitter);
+            jitter[0] = spread(env.rng);
+            jitter[1] = spread(env.rng);
+        }
+        match.fighters[0] = FighterState::spawn(match.models[0], GameConfig::WINDOW_WIDTH * 0.25f + jitter[0], true);
+        match.fighters[1] = FighterState::spawn(match.models[1], GameConfig::WINDOW_WIDTH * 0.75f + jitter[1], false);
+
+        env.held[0] = env.held[1] = AIOption::IDLE;
+        env.ticks = 0;
+        env.opponentHoldTicks = 0;
+        observe(i);
+    }
+
+    void observe(int i) {
+        const Env& env = envs[i];
+        writeObservation(env.match, 1, 1.f - static_cast<float>(env.ticks) / roundTicks,
+                         observations.data() + static_cast<std::size_t>(i) * OBS_SIZE);
+    }
+};
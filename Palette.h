@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <SFML/Graphics.hpp>
+
+// --- Palettes ---
+// The fighter sheets are pixel art with a few dozen colours each, so AnimationTable keeps the atlas
+// as palette indices (the index in red, alpha as drawn) and the colours themselves in a palette
+// texture with one row per costume. PaletteShader turns an index back into its costume's colour
+// and multiplies in the vertex colour, which is where the damage flash tint rides. A costume is a
+// row of a few dozen colours instead of another set of sheets.
+
+// A recolour of a preset's own palette, in HSV
+struct Costume {
+    const char* name;
+    float hueShift;   // Degrees
+    float saturation; // Multiplier
+    float value;      // Multiplier
+};
+
+const Costume Costumes[] = {
+    {"Default", 0.f, 1.f, 1.f},
+    {"Ember", 160.f, 1.15f, 1.f},  // Mirror matches give the enemy this one
+    {"Verdant", 90.f, 1.f, 0.95f},
+    {"Shade", 0.f, 0.2f, 0.65f}
+};
+const int COSTUME_COUNT = sizeof(Costumes) / sizeof(Costumes[0]);
+
+inline sf::Color applyCostume(sf::Color color, const Costume& costume) {
+    float r = color.r / 255.f, g = color.g / 255.f, b = color.b / 255.f;
+    float high = std::max({r, g, b}), low = std::min({r, g, b}), range = high - low;
+    float hue = 0.f;
+    if (range > 0.f) {
+        if (high == r) hue = 60.f * std::fmod((g - b) / range, 6.f);
+        else if (high == g) hue = 60.f * ((b - r) / range + 2.f);
+        else hue = 60.f * ((r - g) / range + 4.f);
+    }
+    float saturation = high > 0.f ? range / high : 0.f;
+
+    hue = std::fmod(hue + costume.hueShift + 360.f, 360.f);
+    saturation = std::min(saturation * costume.saturation, 1.f);
+    float value = std::min(high * costume.value, 1.f);
+
+    float chroma = value * saturation;
+    float x = chroma * (1.f - std::abs(std::fmod(hue / 60.f, 2.f) - 1.f));
+    float m = value - chroma;
+    float rgb[3] = {};
+    switch (static_cast<int>(hue / 60.f) % 6) {
+        case 0: rgb[0] = chroma; rgb[1] = x; break;
+        case 1: rgb[0] = x; rgb[1] = chroma; break;
+        case 2: rgb[1] = chroma; rgb[2] = x; break;
+        case 3: rgb[1] = x; rgb[2] = chroma; break;
+        case 4: rgb[0] = x; rgb[2] = chroma; break;
+        default: rgb[0] = chroma; rgb[2] = x; break;
+    }
+    auto channel = [m](float c) { return static_cast<sf::Uint8>(std::lround((c + m) * 255.f)); };
+    return sf::Color(channel(rgb[0]), channel(rgb[1]), channel(rgb[2]), color.a);
+}
+
+// --- Palette Shader ---
+// One fragment shader shared by every indexed fighter; prepare() points it at a palette row just
+// before a draw. Drawing is single-threaded (the render thread), so the shared uniforms are safe.
+class PaletteShader {
+public:
+    static bool isAvailable() { return shader() != nullptr; }
+
+    // The shader set up for `palette` (an AnimationTable's) and `costume`; nullptr without shaders
+    static const sf::Shader* prepare(const sf::Texture& palette, int costume) {
+        sf::Shader* program = shader();
+        if (!program) return nullptr;
+        float rows = static_cast<float>(std::max(palette.getSize().y, 1u));
+        program->setUniform("palette", palette);
+        program->setUniform("paletteSize", static_cast<float>(palette.getSize().x));
+        program->setUniform("row", (std::min(std::max(costume, 0), static_cast<int>(rows) - 1) + 0.5f) / rows);
+        return program;
+    }
+
+private:
+    static sf::Shader* shader() {
+        static sf::Shader program;
+        static const bool loaded = load(program);
+        return loaded ? &program : nullptr;
+    }
+
+    static bool load(sf::Shader& program) {
+        if (!sf::Shader::isAvailable()) return false;
+        // The atlas is never smoothed, so the red channel arrives as the exact index
+        static const char* const source =
+            "uniform sampler2D texture;\n"
+            "uniform sampler2D palette;\n"
+            "uniform float paletteSize;\n"
+            "uniform float row;\n"
+            "void main() {\n"
+            "    vec4 indexed = texture2D(texture, gl_TexCoord[0].xy);\n"
+            "    float index = floor(indexed.r * 255.0 + 0.5);\n"
+            "    vec4 color = texture2D(palette, vec2((index + 0.5) / paletteSize, row));\n"
+            "    gl_FragColor = vec4(color.rgb, indexed.a) * gl_Color;\n"
+            "}\n";
+        if (!program.loadFromMemory(source, sf::Shader::Fragment)) {
+            std::cerr << "Palette shader failed to compile; fighters are drawn from true-colour atlases" << std::endl;
+            return false;
+        }
+        program.setUniform("texture", sf::Shader::CurrentTexture);
+        return true;
+    }
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// --- Perf Counters ---
+// Hardware counters for this thread (cycles, instructions, cache misses, branch misses) read
+// around a block of code with Linux perf_event_open. The four are opened as one group so they
+// count over exactly the same instructions; user space only. Used by bench --counters to put
+// IPC and misses per operation next to the timings.
+//
+// Needs Linux and permission to read counters (kernel.perf_event_paranoid <= 2 for user-space
+// counting of your own process). Elsewhere, or when the kernel refuses, open() returns false,
+// error() says why, and everything else does nothing.
+class PerfCounters {
+public:
+    enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, COUNT };
+
+    struct Values {
+        double counts[COUNT] = {};
+        bool multiplexed = false; // The group shared the PMU with someone else; counts are scaled
+
+        double ipc() const { return counts[CYCLES] > 0.0 ? counts[INSTRUCTIONS] / counts[CYCLES] : 0.0; }
+    };
+
+    PerfCounters() = default;
+    ~PerfCounters() { close(); }
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool open() {
+#if defined(__linux__)
+        if (isOpen()) return true;
+        const std::uint64_t configs[COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for (int i = 0; i < COUNT; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = i == 0; // The leader starts the whole group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0));
+            if (fd < 0) {
+                lastError = std::string("perf_event_open: ") + std::strerror(errno) +
+                            (errno == EACCES || errno == EPERM ? " (check /proc/sys/kernel/perf_event_paranoid)" : "");
+                close();
+                return false;
+            }
+            fds[i] = fd;
+        }
+        return true;
+#else
+        lastError = "hardware counters are only supported on Linux";
+        return false;
+#endif
+    }
+
+    bool isOpen() const { return fds[0] >= 0; }
+    const std::string& error() const { return lastError; }
+
+    void start() {
+#if defined(__linux__)
+        if (!isOpen()) return;
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Counts since start()
+    Values stop() {
+        Values values;
+#if defined(__linux__)
+        if (!isOpen()) return values;
+        ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        // { nr, time_enabled, time_running, value[nr] }
+        std::uint64_t data[3 + COUNT] = {};
+        if (read(fds[0], data, sizeof(data)) < static_cast<ssize_t>(sizeof(std::uint64_t) * 3)) return values;
+        double scale = 1.0;
+        if (data[2] > 0 && data[2] < data[1]) {
+            scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            values.multiplexed = true;
+        }
+        for (std::uint64_t i = 0; i < data[0] && i < COUNT; ++i) values.counts[i] = data[3 + i] * scale;
+#endif
+        return values;
+    }
+
+    void close() {
+#if defined(__linux__)
+        for (int& fd : fds) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+private:
+    int fds[COUNT] = {-1, -1, -1, -1};
+    std::string lastError;
+};
@@ -0,0 +1,178 @@
+#pragma once
+#include <cstdio>
+#include <SFML/Graphics.hpp>
+#include "AllocTracker.h"
+#include "GlyphAtlas.h"
+#include "RenderStats.h"
+#include "ResourceManager.h"
+
+// --- Perf Overlay ---
+// F2 debug panel: a rolling frame-time graph plus the last frame's phase timings, draw calls,
+// texture binds and estimated texture memory. Built to stay well under 0.2 ms: the graph is a
+// single quad array patched in place, the text comes from a small glyph atlas in one draw call,
+// and the labels are only re-formatted a few times per second. Its own cost is shown too.
+// Builds with HELLFIRE_TRACK_ALLOCS add a line of heap allocations per frame and per tick.
+class PerfOverlay {
+public:
+    static constexpr int HISTORY = 240;  // Frames in the graph
+    const sf::Vector2f PANEL_SIZE = sf::Vector2f(480, 190);
+    const sf::Vector2f GRAPH_SIZE = sf::Vector2f(HISTORY * 1.5f, 60);
+    const float GRAPH_MAX_MS = 33.3f;    // Top of the graph; taller frames are clipped
+    const sf::Time TEXT_REFRESH = sf::milliseconds(250);
+
+    // One presented frame. `update` and `transition` come from the simulation tick shown.
+    struct Sample {
+        sf::Time frame;      // Present to present
+        sf::Time events;     // Game::processEvents
+        sf::Time update;     // Game::update (screen and fighter logic)
+        sf::Time transition; // Game::handleScreenTransition
+        sf::Time render;     // Game::render up to present, excluding pacing waits
+        sf::Time gpu;        // Waiting for the GPU to finish the frame (only with Game::measureGpuTime)
+        AllocTracker::Counters frameAllocations; // Render thread, since the previous present
+        AllocTracker::Counters tickAllocations;  // Simulation thread, one whole tick
+    };
+
+    bool visible = false;
+
+    PerfOverlay() : shapes(sf::Quads), text(256) {}
+
+    void setFont(const sf::Font& font) {
+        textStyle = atlas.addStyle(14, 0.f);
+        atlasReady = atlas.build(font);
+        ResourceManager::trackTexture(atlas.getTexture());
+    }
+
+    void toggle() { visible = !visible; }
+
+    void recordFrame(const Sample& sample) {
+        history[head] = sample.frame.asMicroseconds() / 1000.f;
+        head = (head + 1) % HISTORY;
+        last = sample;
+    }
+
+    // Draws in the virtual 1280x720 view, bottom-left. Extra lines are supplied by the game.
+    void draw(sf::RenderTarget& target, const sf::Clock& timeline, const char* pacingLine) {
+        if (!visible) return;
+        sf::Time start = timeline.getElapsedTime();
+
+        if (shapes.getVertexCount() == 0) layout();
+        updateGraph();
+
+        if (start - lastTextRefresh >= TEXT_REFRESH) {
+            lastTextRefresh = start;
+            rebuildText(pacingLine);
+        }
+
+        RenderStats::draw(target, shapes);
+        if (atlasReady) text.draw(target, atlas);
+
+        selfCost = timeline.getElapsedTime() - start;
+    }
+
+private:
+    GlyphAtlas atlas;
+    bool atlasReady = false;
+    int textStyle = 0;
+
+    sf::VertexArray shapes;  // [panel][16.7 ms line][bars...]
+    TextBatch text;
+    sf::Vector2f panelPos;
+    sf::Vector2f graphPos;
+    std::size_t barsStart = 0;
+
+    float history[HISTORY] = {};
+    int head = 0;
+    Sample last;
+    sf::Time lastTextRefresh;
+    sf::Time selfCost;
+    std::uint64_t scopeCounts[AllocTracker::MAX_SCOPES] = {}; // Allocation counts at the last text refresh
+
+    void layout() {
+        panelPos = sf::Vector2f(15.f, GameConfig::WINDOW_HEIGHT - PANEL_SIZE.y - 15.f);
+        graphPos = sf::Vector2f(panelPos.x + 10.f, panelPos.y + PANEL_SIZE.y - GRAPH_SIZE.y - 10.f);
+
+        shapes.clear();
+        appendRect(sf::FloatRect(panelPos, PANEL_SIZE), sf::Color(0, 0, 0, 190));
+        float budgetY = graphPos.y + GRAPH_SIZE.y * (1.f - (1000.f / 60.f) / GRAPH_MAX_MS);
+        appendRect(sf::FloatRect(graphPos.x, budgetY, GRAPH_SIZE.x, 1.f), sf::Color(255, 255, 255, 90));
+
+        barsStart = shapes.getVertexCount();
+        for (int i = 0; i < HISTORY; ++i) {
+            appendRect(sf::FloatRect(graphPos.x + i * 1.5f, graphPos.y + GRAPH_SIZE.y, 1.5f, 0.f), sf::Color::Green);
+        }
+    }
+
+    // Oldest frame on the left; only the y-coordinates and colors change
+    void updateGraph() {
+        float bottom = graphPos.y + GRAPH_SIZE.y;
+        for (int i = 0; i < HISTORY; ++i) {
+            float ms = history[(head + i) % HISTORY];
+            float height = std::min(ms / GRAPH_MAX_MS, 1.f) * GRAPH_SIZE.y;
+            sf::Color color = ms <= 17.f ? sf::Color(80, 220, 80) : (ms <= 34.f ? sf::Color(240, 200, 60) : sf::Color(230, 60, 60));
+
+            sf::Vertex* quad = &shapes[barsStart + i * 4];
+            quad[0].position.y = quad[1].position.y = bottom - height;
+            quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+        }
+    }
+
+    void rebuildText(const char* pacingLine) {
+        float worst = 0.f;
+        for (float ms : history) worst = std::max(worst, ms);
+        float frameMs = last.frame.asMicroseconds() / 1000.f;
+        const RenderStats::Counters& stats = RenderStats::lastFrame();
+
+        char line[128];
+        sf::Vector2f pos(panelPos.x + 10.f, panelPos.y + 6.f);
+        text.clear();
+
+        std::snprintf(line, sizeof(line), "FPS %.0f   frame %.2f ms   worst %.2f ms",
+                      frameMs > 0.f ? 1000.f / frameMs : 0.f, frameMs, worst);
+        appendLine(line, pos);
+        std::snprintf(line, sizeof(line), "events %.2f  update %.2f  transition %.2f  render %.2f ms",
+                      ms(last.events), ms(last.update), ms(last.transition), ms(last.render));
+        appendLine(line, pos);
+        std::snprintf(line, sizeof(line), "draw calls %u   texture binds %u   textures %.1f MB",
+                      stats.drawCalls, stats.textureBinds, ResourceManager::getTextureMemoryBytes() / (1024.f * 1024.f));
+        appendLine(line, pos);
+        std::snprintf(line, sizeof(line), "%s   overlay %.3f ms", pacingLine, ms(selfCost));
+        appendLine(line, pos);
+        if (AllocTracker::enabled) {
+            const char* topScope = busiestAllocScope();
+            std::snprintf(line, sizeof(line), "allocs frame %llu (%.1f KB)  tick %llu (%.1f KB)  top %s",
+                          static_cast<unsigned long long>(last.frameAllocations.count), last.frameAllocations.bytes / 1024.f,
+                          static_cast<unsigned long long>(last.tickAllocations.count), last.tickAllocations.bytes / 1024.f,
+                          topScope ? topScope : "-");
+            appendLine(line, pos);
+        }
+    }
+
+    // Scope with the most allocations since the last text refresh
+    const char* busiestAllocScope() {
+        const char* busiest = nullptr;
+        std::uint64_t most = 0;
+        for (int i = 0; i < AllocTracker::MAX_SCOPES; ++i) {
+            std::uint64_t count = AllocTracker::scopes[i].count.load(std::memory_order_relaxed);
+            if (count - scopeCounts[i] > most) {
+                most = count - scopeCounts[i];
+                busiest = AllocTracker::scopes[i].name.load(std::memory_order_relaxed);
+            }
+            scopeCounts[i] = count;
+        }
+        return busiest;
+    }
+
+    void appendLine(const char* line, sf::Vector2f& pos) {
+        if (atlasReady) text.append(atlas, textStyle, line, pos, sf::Color(230, 230, 230));
+        pos.y += 20.f;
+    }
+
+    static float ms(sf::Time t) { return t.asMicroseconds() / 1000.f; }
+
+    void appendRect(const sf::FloatRect& rect, sf::Color color) {
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left + rect.width, rect.top + rect.height), color));
+        shapes.append(sf::Vertex(sf::Vector2f(rect.left, rect.top + rect.height), color));
+    }
+};
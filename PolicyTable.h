@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "FighterAI.h"
+#include "FighterSim.h"
+#include "Trace.h"
+
+// --- Policy Table ---
+// An AI compiled ahead of time: policy_compile.cpp plays self-play matches in FighterSim, scores
+// every option from the situations it meets, and keeps the best option per situation in a
+// one-byte cell. At runtime the situation is a handful of compares and the decision is one read.
+//
+// A situation (cell) is the distance band to the opponent, their height relative to ours, the
+// opponent's Action, our own cooldown state and the character pairing. The file is a small header
+// that records those dimensions (so a table built for another binning is refused) and the cells.
+
+class PolicyTable {
+public:
+    static const int DISTANCE_BINS = 12;              // |dx| between hurtbox centres...
+    static const int DISTANCE_STEP = 40;              // ...in bands this wide, the last one open-ended
+    static const int HEIGHT_BINS = 3;                 // Opponent well below, level with, well above us
+    static const int HEIGHT_LEVEL = 40;               // Pixels of difference that still count as level
+    static const int COOLDOWN_STATES = 3;             // Ready to swing, mid-swing, recovering
+    static const int CHARACTERS = 3;                  // CharacterTypeID values
+    static const int CELLS = DISTANCE_BINS * HEIGHT_BINS * ACTION_COUNT * COOLDOWN_STATES * CHARACTERS * CHARACTERS;
+
+    static const std::uint32_t MAGIC = 0x54504648; // "HFPT"
+    static const std::uint32_t VERSION = 1;
+
+    std::vector<std::uint8_t> cells; // AIOption per cell; empty until loaded or compiled
+
+    bool isLoaded() const { return static_cast<int>(cells.size()) == CELLS; }
+
+    static int distanceBin(float dx) {
+        return std::min(static_cast<int>(std::abs(dx) / DISTANCE_STEP), DISTANCE_BINS - 1);
+    }
+
+    // `dy` is the opponent's hurtbox centre minus ours; screen y grows downwards
+    static int heightBin(float dy) {
+        return dy > HEIGHT_LEVEL ? 0 : (dy < -HEIGHT_LEVEL ? 2 : 1);
+    }
+
+    static int cooldownState(bool canAttack, bool attacking) {
+        return attacking ? 1 : (canAttack ? 0 : 2);
+    }
+
+    static int cell(float dx, float dy, Character::Action opponentAction, bool canAttack, bool attacking,
+                    CharacterTypeID self, CharacterTypeID opponent) {
+        int index = static_cast<int>(self) * CHARACTERS + static_cast<int>(opponent);
+        index = index * COOLDOWN_STATES + cooldownState(canAttack, attacking);
+        index = index * ACTION_COUNT + static_cast<int>(opponentAction);
+        index = index * HEIGHT_BINS + heightBin(dy);
+        return index * DISTANCE_BINS + distanceBin(dx);
+    }
+
+    // The same key from a simulated match, for the compiler
+    static int cell(const MatchState& match, int side) {
+        const FighterState& me = match.fighters[side];
+        const FighterState& them = match.fighters[1 - side];
+        sf::FloatRect mine = me.hurtbox(match.models[side]);
+        sf::FloatRect theirs = them.hurtbox(match.models[1 - side]);
+        float dx = (theirs.left + theirs.width / 2.f) - (mine.left + mine.width / 2.f);
+        float dy = (theirs.top + theirs.height / 2.f) - (mine.top + mine.height / 2.f);
+        return cell(dx, dy, them.action, me.canAttack, me.attacking, match.models[side].type, match.models[1 - side].type);
+    }
+
+    AIOption lookup(int index) const { return static_cast<AIOption>(cells[index]); }
+
+    bool load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::uint32_t header[3 + 6] = {};
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+        std::uint32_t expected[3 + 6];
+        writeHeader(expected);
+        if (std::memcmp(header, expected, sizeof(header)) != 0) return false; // Other binning or version: recompile
+
+        std::vector<std::uint8_t> data(CELLS);
+        if (!in.read(reinterpret_cast<char*>(data.data()), CELLS)) return false;
+        for (std::uint8_t option : data) {
+            if (option >= AI_OPTION_COUNT) return false;
+        }
+        cells.swap(data);
+        return true;
+    }
+
+    bool save(const std::string& path) const {
+        if (!isLoaded()) return false;
+        std::ofstream out(path, std::ios::binary);
+        std::uint32_t header[3 + 6];
+        writeHeader(header);
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(cells.data()), CELLS);
+        return static_cast<bool>(out);
+    }
+
+private:
+    static void writeHeader(std::uint32_t (&header)[3 + 6]) {
+        const std::uint32_t values[] = {MAGIC, VERSION, CELLS, DISTANCE_BINS, DISTANCE_STEP, HEIGHT_BINS,
+                                        ACTION_COUNT, COOLDOWN_STATES, CHARACTERS};
+        std::copy(std::begin(values), std::end(values), header);
+    }
+};
+
+// --- Table AI ---
+// The "Table" difficulty, for machines that can't spare the Expert's search threads: every
+// reactionTicks it works out its cell from the live fighters and plays what the table says.
+class TableAI : public FighterAI {
+public:
+    const PolicyTable* table;
+    AIProfile profile;
+    AIBudget* budget;
+    AIOption current = AIOption::IDLE;
+
+    TableAI(const PolicyTable* policy, const AIProfile& aiProfile, AIBudget* sharedBudget = nullptr)
+        : table(policy), profile(aiProfile), budget(sharedBudget) {}
+
+    void reset() override {
+        current = AIOption::IDLE;
+        ticksUntilDecision = 0;
+    }
+
+    void decide(const Character& self, const Character& opponent, FighterInput& out) override {
+        TRACE_SCOPE("TableAI::decide");
+        sf::FloatRect mine = self.getHurtbox();
+        sf::FloatRect theirs = opponent.getHurtbox();
+        float dx = (theirs.left + theirs.width / 2.f) - (mine.left + mine.width / 2.f);
+
+        if (--ticksUntilDecision <= 0) {
+            float dy = (theirs.top + theirs.height / 2.f) - (mine.top + mine.height / 2.f);
+            current = table->lookup(PolicyTable::cell(dx, dy, opponent.currentAction, self.canAttack, self.isAttacking,
+                                                      self.charType, opponent.charType));
+            ticksUntilDecision = profile.reactionTicks;
+            if (budget) budget->charge(0); // Counted, not timed: reading the clock would cost more than the lookup
+        }
+        pressOption(current, dx, self.facingRight == (dx >= 0.f), out);
+    }
+
+private:
+    int ticksUntilDecision = 0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Enums.h"
+#include "AllocTracker.h"
+#include "GameConfig.h"
+
+// --- Render Snapshot ---
+// Everything needed to draw one gameplay frame, copied out of the simulation at the end of a
+// tick. The background sprite and fighter views only point at textures (the fighter atlases and
+// palettes, the map frame lists); the rest is plain values, so the renderer can draw it while the
+// next tick is simulated.
+struct RenderSnapshot {
+    static constexpr int MAX_DAMAGE_TEXTS = 16;
+
+    struct DamageTextView {
+        char label[8];
+        sf::Vector2f position; // Center of the label
+        sf::Vector2f previousPosition;
+        sf::Color color;
+    };
+
+    bool valid = false;
+    std::uint64_t tick = 0;
+    sf::Time publishedAt; // On Game::timeline; drives the interpolation factor
+    sf::Time tickLength;
+    sf::Time inputSampledAt; // When this tick's fighter input was read; present minus this is the latency
+    sf::Time updateTime, transitionTime; // How long this tick's update / transition phases took (perf overlay)
+    AllocTracker::Counters tickAllocations; // Heap allocations of the previous tick (this one is still counting when published)
+    GameStateID state = GameStateID::MENU;
+    TransitionState transition = TransitionState::NONE;
+
+    sf::Sprite background;
+    bool hasBackground = false;
+    const std::vector<sf::Texture>* backgroundFrames = nullptr; // Animation frames of the map, if animated
+    int backgroundFrame = 0;
+    float backgroundFrameTime = 0.f;  // Time spent on backgroundFrame so far
+    float backgroundFrameDelay = 0.f;
+    // A fighter's frame as Character::frameQuad builds it, drawn translated to `position`
+    struct FighterView {
+        const sf::Texture* texture = nullptr;
+        const sf::Texture* palette = nullptr; // Set when `texture` holds palette indices
+        int costume = 0;
+        sf::Vertex quad[4];
+        sf::Vector2f position;
+    };
+    FighterView fighters[2]; // Player, enemy
+    sf::Vector2f shakeOffset;
+
+    // State at the start of this tick; the renderer draws in between this and the values above
+    sf::Vector2f previousFighterPositions[2];
+    sf::Vector2f previousShakeOffset;
+
+    // HUD values
+    char names[2][GameConfig::MAX_NAME_LENGTH + 1] = {};
+    float healthRatio[2] = { 1.f, 1.f };
+    int timerSeconds = 0;
+    DamageTextView damageTexts[MAX_DAMAGE_TEXTS];
+    int damageTextCount = 0;
+
+    bool showDebugHitboxes = false;
+    bool pixelPreciseHits = false; // F5 mode, for the F2 overlay
+    sf::FloatRect attackHitboxes[2];
+    sf::FloatRect hurtboxes[2];
+
+    // How far the display is between the previous tick and this one, in [0, 1]. The renderer
+    // runs a tick behind the simulation and lerps by this; 1 means "draw this tick as is".
+    float interpolationAlpha(sf::Time now) const {
+        if (tickLength <= sf::Time::Zero) return 1.f;
+        float alpha = (now - publishedAt).asSeconds() / tickLength.asSeconds();
+        return alpha < 0.f ? 0.f : (alpha > 1.f ? 1.f : alpha);
+    }
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// --- Render Stats ---
+// Counts what the renderer submits each frame: draw calls and texture binds. sf::RenderTarget::draw
+// can't be hooked, so render code draws through RenderStats::draw, which forwards to the target and
+// mirrors SFML's state cache: a bind is counted whenever a draw uses a different texture (or none)
+// than the draw before it. Shapes and texts with an outline are two draw calls, as in SFML.
+// Render thread only.
+namespace RenderStats {
+    struct Counters {
+        unsigned int drawCalls = 0;
+        unsigned int textureBinds = 0;
+    };
+
+    struct State {
+        Counters current;
+        Counters lastFrame;
+        const sf::Texture* boundTexture = nullptr;
+        bool bindKnown = false;
+    };
+
+    State& state() {
+        static State s;
+        return s;
+    }
+
+    // Call once at the start of every frame; lastFrame() then holds the previous frame's totals
+    void beginFrame() {
+        State& s = state();
+        s.lastFrame = s.current;
+        s.current = Counters();
+        s.bindKnown = false;
+    }
+
+    const Counters& lastFrame() { return state().lastFrame; }
+    const Counters& currentFrame() { return state().current; }
+
+    void countDraw(const sf::Texture* texture) {
+        State& s = state();
+        ++s.current.drawCalls;
+        if (!s.bindKnown || s.boundTexture != texture) {
+            ++s.current.textureBinds;
+            s.boundTexture = texture;
+            s.bindKnown = true;
+        }
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default) {
+        countDraw(sprite.getTexture());
+        target.draw(sprite, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default) {
+        countDraw(shape.getTexture());                          // Fill
+        if (shape.getOutlineThickness() != 0.f) countDraw(nullptr); // Outline is drawn untextured
+        target.draw(shape, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default) {
+        const sf::Texture* page = text.getFont() ? &text.getFont()->getTexture(text.getCharacterSize()) : nullptr;
+        if (text.getOutlineThickness() != 0.f) countDraw(page); // Outline pass
+        countDraw(page);
+        target.draw(text, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default) {
+        countDraw(states.texture);
+        target.draw(vertices, states);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default) {
+        countDraw(states.texture);
+        target.draw(vertices, count, type, states);
+    }
+}
@@ -3,12 +3,18 @@
 #include <iostream>
 #include <map>
 #include <iomanip>
+#include <atomic>
+#include <mutex>
+#include "Trace.h"
+#include "FlightRecorder.h"
 
 // --- Resource Manager ---
 class ResourceManager {
 public:
     static sf::Font& getFont(const std::string& id) {
         if (fonts.find(id) == fonts.end()) {
+            TRACE_SCOPE_DETAIL("ResourceManager::getFont", id);
+            FlightRecorder::AssetLoad flightLoad("getFont", id);
             if (!fonts[id].loadFromFile(id)) {
                 std::cerr << "Failed to load font '" << id << "'" << std::endl;
             }
@@ -19,8 +25,12 @@ public:
     // General texture loading method
     static sf::Texture& getTexture(const std::string& id) {
         if (textures.find(id) == textures.end()) {
+            TRACE_SCOPE_DETAIL("ResourceManager::getTexture", id);
+            FlightRecorder::AssetLoad flightLoad("getTexture", id);
             if (!textures[id].loadFromFile(id)) {
                 std::cerr << "Failed to load texture '" << id << "'" << std::endl;
+            } else {
+                trackTexture(textures[id]);
             }
         }
         return textures[id];
@@ -28,21 +38,28 @@ public:
     
     // Specific bool returning texture loader for resource checks
     static bool loadTexture(sf::Texture& tex, const std::string& filename) {
+        TRACE_SCOPE_DETAIL("ResourceManager::loadTexture", filename);
+        FlightRecorder::AssetLoad flightLoad("loadTexture", filename);
         if (!tex.loadFromFile(filename)) {
             std::cerr << "Failed to load texture: " << filename << std::endl;
-            return false;
+            return false; // The texture keeps what it held before, and its entry with it
         }
+        trackTexture(tex);
         return true;
     }
 
  static void loadMenuBackgroundFrames(std::vector<sf::Texture>& frames, int count) {
+    TRACE_SCOPE("ResourceManager::loadMenuBackgroundFrames");
+    untrackTextures(frames);
     frames.resize(count);
     for (int i = 0; i < count; ++i) {
         std::stringstream ss;
         ss << "assets/" << std::setw(5) << std::setfill('0') << (i + 1) << ".png";
         if (!frames[i].loadFromFile(ss.str())) {
             std::cerr << "Failed to load menu frame: " << ss.str() << std::endl;
+            continue;
         }
+        trackTexture(frames[i]);
     }
 }
 
@@ -50,6 +67,10 @@ public:
     static bool loadMapFrames(std::vector<sf::Texture>& frames, int frameCount,
                           const std::string& prefix, const std::string& suffix,
                           int startNum = 1, int zeroPadding = 0) {
+    const std::string pattern = prefix + "*" + suffix;
+    TRACE_SCOPE_DETAIL("ResourceManager::loadMapFrames", pattern);
+    FlightRecorder::AssetLoad flightLoad("loadMapFrames", prefix);
+    untrackTextures(frames);
     frames.clear();
     frames.resize(frameCount);
     for (int i = 0; i < frameCount; ++i) {
@@ -61,9 +82,37 @@ public:
             std::cerr << "Failed to load map frame: " << ss.str() << std::endl;
             return false;
         }
+        trackTexture(frames[i]);
     }
     return true;
 }
+
+    // --- Texture memory estimate ---
+    // Width x height x 4 bytes for every texture loaded through here (plus any registered with
+    // trackTexture, like the glyph atlas), keyed by texture so reloading one replaces its entry.
+    // Only successful loads are counted. Loads happen on the simulation thread while the perf overlay
+    // reads the total on the render thread, so the map is only touched under textureStatsMutex.
+    static void trackTexture(const sf::Texture& tex) {
+        std::lock_guard<std::mutex> lock(textureStatsMutex);
+        std::size_t bytes = static_cast<std::size_t>(tex.getSize().x) * tex.getSize().y * 4;
+        std::size_t& entry = textureBytes[&tex];
+        textureMemoryBytes += bytes;
+        textureMemoryBytes -= entry;
+        entry = bytes;
+    }
+
+    static void untrackTextures(const std::vector<sf::Texture>& texs) {
+        std::lock_guard<std::mutex> lock(textureStatsMutex);
+        for (const sf::Texture& tex : texs) {
+            auto it = textureBytes.find(&tex);
+            if (it == textureBytes.end()) continue;
+            textureMemoryBytes -= it->second;
+            textureBytes.erase(it);
+        }
+    }
+
+    static std::size_t getTextureMemoryBytes() { return textureMemoryBytes.load(std::memory_order_relaxed); }
+
 ~ResourceManager() {
         // Clean up loaded resources if necessary
         fonts.clear();
@@ -72,6 +121,9 @@ public:
 private:
     static std::map<std::string, sf::Font> fonts;
     static std::map<std::string, sf::Texture> textures;
+    static std::map<const sf::Texture*, std::size_t> textureBytes;
+    static std::mutex textureStatsMutex;
+    static std::atomic<std::size_t> textureMemoryBytes;
 };
 
 
@@ -79,3 +131,6 @@ private:
 // Static member definitions
 std::map<std::string, sf::Font> ResourceManager::fonts;
 std::map<std::string, sf::Texture> ResourceManager::textures;
+std::map<const sf::Texture*, std::size_t> ResourceManager::textureBytes;
+std::mutex ResourceManager::textureStatsMutex;
+std::atomic<std::size_t> ResourceManager::textureMemoryBytes{0};
@@ -0,0 +1,353 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FighterAI.h"
+#include "FighterSim.h"
+#include "GameConfig.h"
+#include "Trace.h"
+
+// --- Search AI ---
+// The Expert opponent. Every few ticks it snapshots the match into a MatchState and hands it to a
+// pool of worker threads, which play the options forward with FighterSim: each of our options
+// against each predicted reply, held for HOLD_TICKS, then a rollout (us greedy, them keeping
+// to their reply), scored on the health difference. That is minimax over (our option, their reply)
+// plies, softened towards the average reply, deepened one ply per pass until the deadline. The
+// average is weighted by what the opponent has actually been doing at each search, so a player who
+// stands still gets walked up to instead of waited out.
+//
+// The search never blocks the tick: decide() only copies the state and posts it, and picks the
+// result up on a later tick (a few milliseconds of "reaction time" on top of reactionTicks).
+// Workers stop at a hard deadline, and the deepest pass that finished in time is used.
+class SearchAI : public FighterAI {
+public:
+    static const int HOLD_TICKS = 6;     // Ticks each ply's options are held for
+    static const int ROLLOUT_TICKS = 60; // Greedy play after the last ply, before scoring (longer than an attack cooldown)
+    static const int MAX_DEPTH = 3;      // Plies; 32^depth leaves, so 3 rarely finishes on slow machines
+    static const int REPLY_COUNT = 4;
+    static constexpr float PESSIMISM = 0.6f; // Weight of the worst reply against the average one
+    static constexpr float HABIT_RATE = 0.1f; // How fast observed replies replace the uniform prior
+    static constexpr float HABIT_FLOOR = 0.05f; // Replies rarer than this no longer count as the worst case
+
+    AIProfile profile;
+    AIBudget* budget;
+    AIOption current = AIOption::IDLE;
+
+    // `selfIndex` is which side of the match we play: 0 player, 1 enemy (FighterSim's order)
+    SearchAI(const AIProfile& aiProfile, AIBudget* sharedBudget = nullptr, int selfIndex = 1,
+             std::chrono::microseconds deadline = std::chrono::microseconds(static_cast<long long>(GameConfig::SEARCH_AI_BUDGET_MS * 1000.f)),
+             int threads = GameConfig::SEARCH_AI_THREADS)
+        : profile(aiProfile), budget(sharedBudget), self(selfIndex), searchTime(deadline) {
+        if (threads <= 0) {
+            int hardware = static_cast<int>(std::thread::hardware_concurrency());
+            threads = std::max(1, std::min(hardware - 2, 8)); // Leave the render and simulation threads a core each
+        }
+        for (int i = 0; i < threads; ++i) workers.emplace_back(&SearchAI::workerLoop, this);
+    }
+
+    ~SearchAI() override {
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void reset() override {
+        waitForJob();
+        searching = false;
+        current = AIOption::IDLE;
+        ticksUntilSearch = 0;
+        std::fill(std::begin(habits), std::end(habits), 1.f / REPLY_COUNT);
+    }
+
+    void decide(const Character& selfFighter, const Character& opponent, FighterInput& out) override {
+        TRACE_SCOPE("SearchAI::decide");
+        if (searching && job.finished.load(std::memory_order_acquire)) {
+            current = collect();
+            searching = false;
+        }
+
+        if (!searching && --ticksUntilSearch <= 0) {
+            if (!budget || budget->hasTimeLeft()) {
+                auto start = std::chrono::steady_clock::now();
+                post(self == 0 ? FighterSim::capture(selfFighter, opponent) : FighterSim::capture(opponent, selfFighter));
+                ticksUntilSearch = profile.reactionTicks;
+                if (budget) {
+                    budget->charge(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+                }
+            } else {
+                ++budget->deferred;
+            }
+        }
+
+        AIPerception p = AIPerception::observe(selfFighter, opponent);
+        pressOption(current, p.dx, p.facingOpponent, out);
+    }
+
+    // Searches `root` and waits for the answer (benchmarks and tuning; the game never waits)
+    AIOption searchNow(const MatchState& root) {
+        waitForJob(); // A search posted by decide() may still be running on the job post() rewrites
+        post(root);
+        waitForJob();
+        searching = false;
+        return collect();
+    }
+
+    int threadCount() const { return static_cast<int>(workers.size()); }
+    int lastDepth() const { return completedDepth; }
+
+    // Shared with MatchEnv's scripted opponents
+    static float offset(const MatchState& state, int side) {
+        sf::FloatRect mine = state.fighters[side].hurtbox(state.models[side]);
+        sf::FloatRect theirs = state.fighters[1 - side].hurtbox(state.models[1 - side]);
+        return (theirs.left + theirs.width / 2.f) - (mine.left + mine.width / 2.f);
+    }
+
+    static FighterInput buttons(const MatchState& state, int side, AIOption option) {
+        float dx = offset(state, side);
+        FighterInput input;
+        pressOption(option, dx, state.fighters[side].facingRight == (dx >= 0.f), input);
+        return input;
+    }
+
+    // Rollout policy for both sides: swing when it would land, otherwise close in. Swings start at
+    // the front of the sprite, so fighters standing on top of each other have to back off first
+    static AIOption greedy(const MatchState& state, int side) {
+        const FighterState& me = state.fighters[side];
+        const FighterState& them = state.fighters[1 - side];
+        float dx = offset(state, side);
+        sf::FloatRect target = them.hurtbox(state.models[1 - side]);
+        bool inReach = me.attackHitbox(state.models[side], dx >= 0.f).intersects(target);
+        if (inReach) return me.canAttack ? AIOption::ATTACK1 : AIOption::IDLE;
+        if (std::abs(dx) < target.width / 2.f) return AIOption::RETREAT;
+        return AIOption::APPROACH;
+    }
+
+private:
+    // The opponent is assumed to pick from these; fewer replies buys a ply of depth
+    static const AIOption* replies() {
+        static const AIOption options[REPLY_COUNT] = {AIOption::IDLE, AIOption::APPROACH, AIOption::BLOCK, AIOption::ATTACK1};
+        return options;
+    }
+
+    static const int PAIRS = AI_OPTION_COUNT * REPLY_COUNT; // Root (option, reply) pairs, one work item each
+
+    struct Job {
+        MatchState root;
+        std::chrono::steady_clock::time_point deadline;
+        std::atomic<int> nextItem{0};
+        std::atomic<int> running{0};
+        std::atomic<bool> finished{true};
+        std::atomic<std::uint64_t> nodes{0};
+        std::atomic<int> completed[MAX_DEPTH];
+        float values[MAX_DEPTH][AI_OPTION_COUNT][REPLY_COUNT];
+        float weights[REPLY_COUNT];
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point ended;
+    };
+
+    int self;
+    std::chrono::microseconds searchTime;
+    float habits[REPLY_COUNT] = {0.25f, 0.25f, 0.25f, 0.25f}; // Observed reply frequencies, decayed
+    int ticksUntilSearch = 0;
+    bool searching = false;
+    int completedDepth = 0;
+
+    Job job;
+    std::uint64_t generation = 0;
+    std::mutex jobMutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void post(const MatchState& root) {
+        observeOpponent(root);
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            job.root = root;
+            std::copy(std::begin(habits), std::end(habits), job.weights);
+            job.started = std::chrono::steady_clock::now();
+            job.deadline = job.started + searchTime;
+            job.nextItem.store(0);
+            job.nodes.store(0);
+            for (std::atomic<int>& count : job.completed) count.store(0);
+            job.running.store(static_cast<int>(workers.size()));
+            job.finished.store(false, std::memory_order_release);
+            ++generation;
+        }
+        searching = true;
+        jobReady.notify_all();
+    }
+
+    void waitForJob() {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobDone.wait(lock, [this] { return job.finished.load(std::memory_order_acquire); });
+    }
+
+    // Best option from the deepest pass where every pair finished in time
+    AIOption collect() {
+        int depth = 0;
+        for (int d = MAX_DEPTH; d >= 1; --d) {
+            if (job.completed[d - 1].load(std::memory_order_acquire) == PAIRS) {
+                depth = d;
+                break;
+            }
+        }
+        completedDepth = depth;
+        if (budget) {
+            std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(job.ended - job.started).count();
+            budget->recordSearch(job.nodes.load(), ns, depth, depth < MAX_DEPTH && job.ended >= job.deadline);
+        }
+        if (depth == 0) return current; // Nothing finished: keep doing what we were doing
+
+        // Exact ties are common when the opponent is out of reach (a later ply makes up for an idle
+        // first one), so they go to the more forward option rather than to IDLE by enum order
+        static const AIOption preference[AI_OPTION_COUNT] = {
+            AIOption::APPROACH, AIOption::ATTACK1, AIOption::ATTACK2, AIOption::ATTACK3,
+            AIOption::IDLE, AIOption::BLOCK, AIOption::JUMP, AIOption::RETREAT
+        };
+        AIOption best = AIOption::IDLE;
+        float bestValue = -1e9f;
+        for (AIOption option : preference) {
+            float value = backup(job.values[depth - 1][static_cast<int>(option)]);
+            if (value > bestValue + 1e-5f) {
+                bestValue = value;
+                best = option;
+            }
+        }
+        return best;
+    }
+
+    void workerLoop() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(jobMutex);
+                jobReady.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            work();
+            if (job.running.fetch_sub(1) == 1) { // Last one out reports the job done
+                std::lock_guard<std::mutex> lock(jobMutex);
+                job.ended = std::chrono::steady_clock::now();
+                job.finished.store(true, std::memory_order_release);
+                jobDone.notify_all();
+            }
+        }
+    }
+
+    // Items are numbered pass by pass, so shallow passes finish before deep ones start
+    void work() {
+        TRACE_SCOPE("SearchAI::search");
+        std::uint64_t nodes = 0;
+        for (;;) {
+            int item = job.nextItem.fetch_add(1);
+            if (item >= PAIRS * MAX_DEPTH) break;
+            int depth = item / PAIRS + 1;
+            int a = (item % PAIRS) / REPLY_COUNT;
+            int b = item % REPLY_COUNT;
+
+            bool timedOut = false;
+            MatchState state = job.root;
+            float value = playPly(state, static_cast<AIOption>(a), replies()[b], depth, nodes, timedOut);
+            if (timedOut) break;
+            job.values[depth - 1][a][b] = value;
+            job.completed[depth - 1].fetch_add(1, std::memory_order_release);
+        }
+        job.nodes.fetch_add(nodes);
+    }
+
+    // Both sides hold their option for a ply, then either the next ply (max over ours, min over
+    // theirs) or a rollout decides the value
+    float playPly(MatchState& state, AIOption ours, AIOption theirs, int depth, std::uint64_t& nodes, bool& timedOut) {
+        for (int t = 0; t < HOLD_TICKS; ++t) stepWith(state, ours, theirs, nodes);
+        if (depth <= 1 || over(state)) return rollout(state, theirs, nodes, timedOut);
+
+        float best = -1e9f;
+        for (int a = 0; a < AI_OPTION_COUNT && !timedOut; ++a) {
+            float outcomes[REPLY_COUNT];
+            for (int b = 0; b < REPLY_COUNT && !timedOut; ++b) {
+                MatchState next = state; // Snapshot; the copy is the restore
+                outcomes[b] = playPly(next, static_cast<AIOption>(a), replies()[b], depth - 1, nodes, timedOut);
+            }
+            if (!timedOut) best = std::max(best, backup(outcomes));
+        }
+        return best;
+    }
+
+    // We play greedily; the opponent keeps the stance of its last predicted reply
+    float rollout(MatchState& state, AIOption theirs, std::uint64_t& nodes, bool& timedOut) {
+        if (std::chrono::steady_clock::now() >= job.deadline) {
+            timedOut = true;
+            return 0.f;
+        }
+        for (int t = 0; t < ROLLOUT_TICKS && !over(state); ++t) {
+            stepWith(state, greedy(state, self), stance(state, 1 - self, theirs), nodes);
+        }
+        return evaluate(state);
+    }
+
+    void stepWith(MatchState& state, AIOption ours, AIOption theirs, std::uint64_t& nodes) {
+        FighterInput inputs[2];
+        inputs[self] = buttons(state, self, ours);
+        inputs[1 - self] = buttons(state, 1 - self, theirs);
+        FighterSim::step(state, inputs[0], inputs[1], 1.0f / GameConfig::SIMULATION_TICK_RATE);
+        ++nodes;
+    }
+
+    // How an option is valued over the predicted replies: mostly its worst case among replies the
+    // opponent still plays, with the habit-weighted average breaking the ties a minimum leaves
+    float backup(const float (&outcomes)[REPLY_COUNT]) const {
+        float worst = 1e9f, expected = 0.f;
+        for (int b = 0; b < REPLY_COUNT; ++b) {
+            if (job.weights[b] >= HABIT_FLOOR) worst = std::min(worst, outcomes[b]);
+            expected += job.weights[b] * outcomes[b];
+        }
+        if (worst > 1e8f) worst = expected;
+        return PESSIMISM * worst + (1.f - PESSIMISM) * expected;
+    }
+
+    // Which reply the opponent is playing right now, folded into the running frequencies
+    void observeOpponent(const MatchState& root) {
+        const FighterState& them = root.fighters[1 - self];
+        int reply = 0; // IDLE, which also covers walking away
+        if (them.attacking) {
+            reply = 3;
+        } else if (them.shielding) {
+            reply = 2;
+        } else if (them.action == Character::Action::RUN && them.facingRight == (offset(root, 1 - self) >= 0.f)) {
+            reply = 1;
+        }
+        for (int b = 0; b < REPLY_COUNT; ++b) habits[b] += HABIT_RATE * ((b == reply ? 1.f : 0.f) - habits[b]);
+    }
+
+    // A reply carried on: blocking and standing still persist, approaching or attacking turn into
+    // the greedy policy. An opponent that waits and swings on contact is already the greedy reply
+    static AIOption stance(const MatchState& state, int side, AIOption reply) {
+        if (reply == AIOption::BLOCK || reply == AIOption::IDLE) return reply;
+        return greedy(state, side);
+    }
+
+    static bool over(const MatchState& state) { return !state.fighters[0].alive || !state.fighters[1].alive; }
+
+    float evaluate(const MatchState& state) const {
+        const FighterState& me = state.fighters[self];
+        const FighterState& them = state.fighters[1 - self];
+        float value = (me.health - them.health) / GameConfig::MAX_HEALTH;
+        if (!them.alive) value += 1.f;
+        if (!me.alive) value -= 1.f;
+        // Out of range nothing else differs within the horizon; a nudge worth well under one hit
+        // (0.048) makes the profile's aggression close the distance
+        float closeness = 1.f - std::min(std::abs(offset(state, self)) / GameConfig::WINDOW_WIDTH, 1.f);
+        return value + 0.01f * profile.aggression * closeness;
+    }
+};
@@ -0,0 +1,314 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FighterAI.h"
+#include "GameConfig.h"
+#include "PolicyTable.h"
+#include "Trace.h"
+
+// --- Shadow Model ---
+// A player's habits: how often they did each thing (as an AIOption) in each situation. The
+// situation uses PolicyTable's binning (distance, height, opponent Action, own cooldown state) plus
+// the option they were already doing, so held runs and follow-ups are learnt as well as single picks.
+// Counts are one byte and the whole context is halved when one of them would overflow. The model
+// stays the same size however long someone plays, and old habits fade as new ones are counted.
+//
+// Lookups back off to coarser contexts when a fine one hasn't been seen often enough: without the
+// previous option, then distance alone.
+struct ShadowModel {
+    static const int SITUATIONS = PolicyTable::DISTANCE_BINS * PolicyTable::HEIGHT_BINS * ACTION_COUNT * PolicyTable::COOLDOWN_STATES;
+    static const int CONTEXTS = SITUATIONS * AI_OPTION_COUNT; // Situation x previous option
+    static const int MIN_SAMPLES = 4; // Counts a context needs before it is trusted over its backoff
+
+    static const std::uint32_t MAGIC = 0x48534648; // "HFSH"
+    static const std::uint32_t VERSION = 1;
+
+    std::uint8_t counts[CONTEXTS][AI_OPTION_COUNT] = {};
+    std::uint8_t situationCounts[SITUATIONS][AI_OPTION_COUNT] = {};
+    std::uint8_t distanceCounts[PolicyTable::DISTANCE_BINS][AI_OPTION_COUNT] = {};
+    std::uint64_t samples = 0; // Ticks counted over the profile's lifetime
+
+    static int situation(float dx, float dy, Character::Action opponentAction, bool canAttack, bool attacking) {
+        int index = PolicyTable::cooldownState(canAttack, attacking);
+        index = index * ACTION_COUNT + static_cast<int>(opponentAction);
+        index = index * PolicyTable::HEIGHT_BINS + PolicyTable::heightBin(dy);
+        return index * PolicyTable::DISTANCE_BINS + PolicyTable::distanceBin(dx);
+    }
+
+    static int context(int situationIndex, AIOption previous) {
+        return situationIndex * AI_OPTION_COUNT + static_cast<int>(previous);
+    }
+
+    bool empty() const { return samples == 0; }
+
+    void add(int contextIndex, AIOption option) {
+        int situationIndex = contextIndex / AI_OPTION_COUNT;
+        count(counts[contextIndex], option);
+        count(situationCounts[situationIndex], option);
+        count(distanceCounts[situationIndex % PolicyTable::DISTANCE_BINS], option);
+        ++samples;
+    }
+
+    // The counts to draw the next option from: a fixed number of steps whatever the history
+    const std::uint8_t* distribution(int contextIndex) const {
+        int situationIndex = contextIndex / AI_OPTION_COUNT;
+        if (total(counts[contextIndex]) >= MIN_SAMPLES) return counts[contextIndex];
+        if (total(situationCounts[situationIndex]) >= MIN_SAMPLES) return situationCounts[situationIndex];
+        return distanceCounts[situationIndex % PolicyTable::DISTANCE_BINS];
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::uint32_t header[4] = {};
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+        if (header[0] != MAGIC || header[1] != VERSION || header[2] != CONTEXTS || header[3] != AI_OPTION_COUNT) return false;
+        // A short read leaves the model half-filled; callers start over from an empty one
+        return in.read(reinterpret_cast<char*>(&samples), sizeof(samples)) &&
+               in.read(reinterpret_cast<char*>(counts), sizeof(counts)) &&
+               in.read(reinterpret_cast<char*>(situationCounts), sizeof(situationCounts)) &&
+               in.read(reinterpret_cast<char*>(distanceCounts), sizeof(distanceCounts));
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        const std::uint32_t header[4] = {MAGIC, VERSION, CONTEXTS, static_cast<std::uint32_t>(AI_OPTION_COUNT)};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&samples), sizeof(samples));
+        out.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+        out.write(reinterpret_cast<const char*>(situationCounts), sizeof(situationCounts));
+        out.write(reinterpret_cast<const char*>(distanceCounts), sizeof(distanceCounts));
+        return static_cast<bool>(out);
+    }
+
+private:
+    static int total(const std::uint8_t (&row)[AI_OPTION_COUNT]) {
+        int sum = 0;
+        for (std::uint8_t c : row) sum += c;
+        return sum;
+    }
+
+    static void count(std::uint8_t (&row)[AI_OPTION_COUNT], AIOption option) {
+        std::uint8_t& c = row[static_cast<int>(option)];
+        if (c == 255) {
+            for (std::uint8_t& other : row) other = static_cast<std::uint8_t>(other / 2);
+        }
+        ++c;
+    }
+};
+
+static_assert(ShadowModel::CONTEXTS <= 65536, "ShadowSample::context is 16 bits");
+
+// One recorded tick: where the player was and what they did about it
+struct ShadowSample {
+    std::uint16_t context;
+    std::uint8_t option;
+};
+
+// --- Shadow Recorder ---
+// Turns the player's controls into ShadowSamples, one per live tick, on the simulation thread.
+// Only this match's ticks are kept; the trainer folds them in and they are dropped.
+class ShadowRecorder {
+public:
+    std::vector<ShadowSample> samples;
+
+    void begin() {
+        samples.clear();
+        samples.reserve(GameConfig::SHADOW_RESERVE_TICKS); // Recording a match shouldn't allocate mid-fight
+        previousInput = FighterInput();
+        previous = AIOption::IDLE;
+    }
+
+    void record(const Character& self, const Character& opponent, const FighterInput& input) {
+        sf::FloatRect mine = self.getHurtbox();
+        sf::FloatRect theirs = opponent.getHurtbox();
+        float dx = (theirs.left + theirs.width / 2.f) - (mine.left + mine.width / 2.f);
+        float dy = (theirs.top + theirs.height / 2.f) - (mine.top + mine.height / 2.f);
+        int situationIndex = ShadowModel::situation(dx, dy, opponent.currentAction, self.canAttack, self.isAttacking);
+
+        AIOption option = classify(input, previousInput, dx);
+        samples.push_back({static_cast<std::uint16_t>(ShadowModel::context(situationIndex, previous)),
+                           static_cast<std::uint8_t>(option)});
+        previousInput = input;
+        previous = option;
+    }
+
+    // The controls as the option an AI would have pressed them with. Swings and jumps count on
+    // the tick the button goes down; holding one afterwards is whatever else is held.
+    static AIOption classify(const FighterInput& input, const FighterInput& before, float dx) {
+        auto pressed = [&](FighterInput::Button button) { return input.has(button) && !before.has(button); };
+        if (pressed(FighterInput::ATTACK1)) return AIOption::ATTACK1;
+        if (pressed(FighterInput::ATTACK2)) return AIOption::ATTACK2;
+        if (pressed(FighterInput::ATTACK3)) return AIOption::ATTACK3;
+        if (pressed(FighterInput::JUMP)) return AIOption::JUMP;
+        if (input.has(FighterInput::SHIELD)) return AIOption::BLOCK;
+        bool left = input.has(FighterInput::LEFT);
+        bool right = input.has(FighterInput::RIGHT);
+        if (left == right) return AIOption::IDLE;
+        return right == (dx >= 0.f) ? AIOption::APPROACH : AIOption::RETREAT;
+    }
+
+private:
+    FighterInput previousInput;
+    AIOption previous = AIOption::IDLE;
+};
+
+// --- Shadow Trainer ---
+// Folds finished matches into each player's model on a background thread, so the results screen
+// never waits on it. Updates are copy-on-write: the worker copies the current model (~70 KB),
+// counts the new match into the copy, saves it and swaps it in. A ShadowAI playing with the old
+// model keeps its own reference and is not disturbed. Only the new match is read, never older ones.
+class ShadowTrainer {
+public:
+    ShadowTrainer() : worker(&ShadowTrainer::workerLoop, this) {}
+
+    // Finishes the queued matches (so none are lost on exit), then stops
+    ~ShadowTrainer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        worker.join();
+    }
+
+    void submit(const std::string& player, std::vector<ShadowSample>&& samples) {
+        if (samples.empty()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({player, std::move(samples)});
+        }
+        jobReady.notify_one();
+    }
+
+    // The player's current model, loaded from disk the first time; an empty model if they have none
+    std::shared_ptr<const ShadowModel> model(const std::string& player) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return modelLocked(player);
+    }
+
+    static std::string profilePath(const std::string& player) {
+        std::string path = GameConfig::SHADOW_PROFILE_PREFIX;
+        for (char c : player) {
+            bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+            path += safe ? c : '_';
+        }
+        return path + ".bin";
+    }
+
+private:
+    struct Job {
+        std::string player;
+        std::vector<ShadowSample> samples;
+    };
+
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::deque<Job> jobs;
+    std::map<std::string, std::shared_ptr<const ShadowModel>> models;
+    bool stopping = false;
+    std::thread worker; // Last, so it starts after everything above is constructed
+
+    std::shared_ptr<const ShadowModel> modelLocked(const std::string& player) {
+        std::shared_ptr<const ShadowModel>& cached = models[player];
+        if (!cached) {
+            auto loaded = std::make_shared<ShadowModel>();
+            if (!loaded->load(profilePath(player))) loaded = std::make_shared<ShadowModel>();
+            cached = loaded;
+        }
+        return cached;
+    }
+
+    void workerLoop() {
+        for (;;) {
+            Job job;
+            std::shared_ptr<const ShadowModel> current;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return; // Stopping with nothing left to save
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                current = modelLocked(job.player);
+            }
+            TRACE_SCOPE("ShadowTrainer::fold");
+            auto updated = std::make_shared<ShadowModel>(*current);
+            for (const ShadowSample& sample : job.samples) {
+                updated->add(sample.context, static_cast<AIOption>(sample.option));
+            }
+            if (!updated->save(profilePath(job.player))) {
+                std::cerr << "Failed to save " << profilePath(job.player) << std::endl;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            models[job.player] = std::move(updated);
+        }
+    }
+};
+
+// --- Shadow AI ---
+// The "Shadow" difficulty: plays like the person holding the other controller has played so far.
+// Every tick it draws its next option from the counts for its current situation and last option.
+// The draw is a single table read plus a walk over eight counts.
+class ShadowAI : public FighterAI {
+public:
+    std::shared_ptr<const ShadowModel> model;
+    AIProfile profile;
+    AIBudget* budget;
+    AIOption current = AIOption::IDLE;
+
+    ShadowAI(std::shared_ptr<const ShadowModel> habits, const AIProfile& aiProfile, AIBudget* sharedBudget = nullptr)
+        : model(std::move(habits)), profile(aiProfile), budget(sharedBudget) {}
+
+    void reset() override {
+        current = AIOption::IDLE;
+        previous = AIOption::IDLE;
+        ticksUntilDecision = 0;
+        rng.seed(RNG_SEED);
+    }
+
+    void decide(const Character& self, const Character& opponent, FighterInput& out) override {
+        TRACE_SCOPE("ShadowAI::decide");
+        sf::FloatRect mine = self.getHurtbox();
+        sf::FloatRect theirs = opponent.getHurtbox();
+        float dx = (theirs.left + theirs.width / 2.f) - (mine.left + mine.width / 2.f);
+
+        if (--ticksUntilDecision <= 0) {
+            float dy = (theirs.top + theirs.height / 2.f) - (mine.top + mine.height / 2.f);
+            int situationIndex = ShadowModel::situation(dx, dy, opponent.currentAction, self.canAttack, self.isAttacking);
+            current = draw(model->distribution(ShadowModel::context(situationIndex, previous)));
+            previous = current; // What the recorder would have seen us do
+            ticksUntilDecision = profile.reactionTicks;
+            if (budget) budget->charge(0); // Counted, not timed, like TableAI
+        }
+        pressOption(current, dx, self.facingRight == (dx >= 0.f), out);
+    }
+
+private:
+    static const std::uint32_t RNG_SEED = 0x5348u;
+    AIOption previous = AIOption::IDLE;
+    int ticksUntilDecision = 0;
+    std::minstd_rand rng{RNG_SEED};
+
+    AIOption draw(const std::uint8_t* counts) {
+        int sum = 0;
+        for (int i = 0; i < AI_OPTION_COUNT; ++i) sum += counts[i];
+        if (sum == 0) return AIOption::APPROACH; // Never seen at this range: close in rather than stand there
+        int pick = std::uniform_int_distribution<int>(0, sum - 1)(rng);
+        for (int i = 0; i < AI_OPTION_COUNT; ++i) {
+            pick -= counts[i];
+            if (pick < 0) return static_cast<AIOption>(i);
+        }
+        return AIOption::IDLE;
+    }
+};
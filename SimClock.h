@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/System.hpp>
+
+// --- Sim Clock ---
+// Same interface as sf::Clock, but measures simulated time rather than wall time. Simulated time
+// only moves when the game advances it by a tick, so gameplay timers (cooldowns, hurt time, the
+// round timer) stay in lock-step with the fixed tick, freeze while paused, and don't care how
+// late a tick runs.
+class SimClock {
+public:
+    SimClock() : startTime(now()) {}
+
+    sf::Time getElapsedTime() const { return now() - startTime; }
+
+    sf::Time restart() {
+        sf::Time current = now();
+        sf::Time elapsed = current - startTime;
+        startTime = current;
+        return elapsed;
+    }
+
+    // Called by the simulation once per tick with the (time-scaled) tick length
+    static void advance(sf::Time dt) { simulatedTime() += dt; }
+    static sf::Time now() { return simulatedTime(); }
+
+private:
+    sf::Time startTime;
+
+    static sf::Time& simulatedTime() {
+        static sf::Time time;
+        return time;
+    }
+};
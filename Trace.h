@@ -0,0 +1,184 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "AllocTracker.h"
+
+// --- Trace ---
+// Scoped timing markers recorded into per-thread ring buffers and dumped as Chrome trace-event
+// JSON (open in chrome://tracing or ui.perfetto.dev). A marker costs two clock reads and an
+// uncontended lock; names must be string literals, and an optional detail (e.g. a file name) is
+// copied into the event. Define HELLFIRE_NO_TRACE to compile every marker out.
+//
+//   TRACE_SCOPE("Game::render");
+//   TRACE_SCOPE_DETAIL("ResourceManager::loadTexture", filename);
+namespace Trace {
+    const std::size_t EVENTS_PER_THREAD = 1 << 15; // Oldest events are overwritten first
+
+    struct Event {
+        const char* name;
+        std::int64_t startUs;
+        std::int64_t durationUs;
+        char detail[48];
+    };
+
+    struct ThreadBuffer {
+        std::mutex mutex; // Only contended while a dump is reading this buffer
+        std::vector<Event> events;
+        std::size_t written = 0; // Total ever written; the ring index is written % size
+        int threadId = 0;
+        std::string threadName;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers; // Kept alive after their thread exits
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    };
+
+    Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    std::int64_t nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - registry().epoch).count();
+    }
+
+    ThreadBuffer& threadBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            buffer->events.resize(EVENTS_PER_THREAD);
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            buffer->threadId = static_cast<int>(r.buffers.size()) + 1;
+            buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+            r.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    // Shown as the track name in the viewer
+    void setThreadName(const char* name) {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.threadName = name;
+    }
+
+    void record(const char* name, const char* detail, std::int64_t startUs, std::int64_t endUs) {
+        ThreadBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        Event& e = buffer.events[buffer.written % buffer.events.size()];
+        e.name = name;
+        e.startUs = startUs;
+        e.durationUs = endUs - startUs;
+        if (detail) {
+            std::strncpy(e.detail, detail, sizeof(e.detail) - 1);
+            e.detail[sizeof(e.detail) - 1] = '\0';
+        } else {
+            e.detail[0] = '\0';
+        }
+        ++buffer.written;
+    }
+
+    class Scope {
+    public:
+        explicit Scope(const char* eventName, const char* eventDetail = nullptr)
+            : name(eventName), startUs(nowUs()) {
+            detail[0] = '\0';
+            if (eventDetail) {
+                std::strncpy(detail, eventDetail, sizeof(detail) - 1);
+                detail[sizeof(detail) - 1] = '\0';
+            }
+        }
+        Scope(const char* eventName, const std::string& eventDetail)
+            : Scope(eventName, eventDetail.c_str()) {}
+        ~Scope() { record(name, detail[0] ? detail : nullptr, startUs, nowUs()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        char detail[sizeof(Event::detail)]; // Copied on entry, so temporaries (prefix + name) are fine
+        std::int64_t startUs;
+    };
+
+    void writeJsonString(std::ofstream& out, const char* str) {
+        out << '"';
+        for (const char* p = str; *p; ++p) {
+            if (*p == '"' || *p == '\\') out << '\\';
+            if (static_cast<unsigned char>(*p) >= 0x20) out << *p;
+        }
+        out << '"';
+    }
+
+    // Writes every buffered event to `path`. Safe to call while other threads keep tracing: each
+    // ring is copied out under its lock and formatted afterwards, so tracing threads only wait
+    // for a memcpy, never for the disk.
+    bool dump(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) return false;
+
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            buffers = r.buffers;
+        }
+
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        std::vector<Event> events;
+        for (const auto& buffer : buffers) {
+            std::string threadName;
+            {
+                std::lock_guard<std::mutex> lock(buffer->mutex);
+                threadName = buffer->threadName;
+                std::size_t count = std::min(buffer->written, buffer->events.size());
+                events.clear();
+                events.reserve(count);
+                for (std::size_t i = buffer->written - count; i < buffer->written; ++i) {
+                    events.push_back(buffer->events[i % buffer->events.size()]);
+                }
+            }
+            out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, threadName.c_str());
+            out << "}}";
+            first = false;
+
+            for (const Event& e : events) {
+                out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << e.startUs << ",\"dur\":" << e.durationUs << ",\"name\":";
+                writeJsonString(out, e.name);
+                if (e.detail[0]) {
+                    out << ",\"args\":{\"detail\":";
+                    writeJsonString(out, e.detail);
+                    out << "}";
+                }
+                out << "}";
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+}
+
+// Trace scopes double as allocation scopes (see AllocTracker.h), even with tracing compiled out
+#ifdef HELLFIRE_NO_TRACE
+#define TRACE_SCOPE(name) ALLOC_SCOPE(name)
+#define TRACE_SCOPE_DETAIL(name, detail) ALLOC_SCOPE(name)
+#else
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name); ALLOC_SCOPE(name)
+#define TRACE_SCOPE_DETAIL(name, detail) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, detail); ALLOC_SCOPE(name)
+#endif
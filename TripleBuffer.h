@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// --- Triple Buffer ---
+// Lock-free single-producer / single-consumer handoff of the latest value. The producer fills
+// writeSlot() and publishes it; the consumer acquires whatever was published most recently and
+// reads it for as long as it likes. Neither side ever waits for the other, and stale values are
+// simply overwritten.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side: fill this completely, then call publish()
+    T& writeSlot() { return slots[writeIndex]; }
+
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(writeIndex | FRESH), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Consumer side: returns true if a newer value was picked up since the last acquire
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+        std::uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T& readSlot() const { return slots[readIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    T slots[3];
+    alignas(64) std::atomic<std::uint8_t> middle{1};
+    alignas(64) std::uint8_t writeIndex = 0; // Owned by the producer
+    alignas(64) std::uint8_t readIndex = 2;  // Owned by the consumer
+};
@@ -2,6 +2,7 @@
 #include <random>
 #include <string>
 #include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
@@ -29,6 +30,10 @@ namespace Utils {
         return a + t * (b - a);
     }
 
+    sf::Vector2f lerp(const sf::Vector2f& a, const sf::Vector2f& b, float t) {
+        return sf::Vector2f(lerp(a.x, b.x, t), lerp(a.y, b.y, t));
+    }
+
     float distance(const sf::Vector2f& p1, const sf::Vector2f& p2) {
         return std::sqrt(std::pow(p2.x - p1.x, 2) + std::pow(p2.y - p1.y, 2));
     }
@@ -37,11 +42,15 @@ namespace Utils {
         std::uniform_real_distribution<float> dist(min, max);
         return dist(rng);
     }
-    std::string formatTime(float seconds) {
+    // Writes "MM:SS" into a caller-owned buffer without allocating; returns the characters written
+    int formatTime(float seconds, char* buffer, std::size_t size) {
         int min = static_cast<int>(seconds) / 60;
         int sec = static_cast<int>(seconds) % 60;
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(2) << min << ":" << std::setfill('0') << std::setw(2) << sec;
-        return ss.str();
+        return std::snprintf(buffer, size, "%02d:%02d", min, sec);
+    }
+    std::string formatTime(float seconds) {
+        char buffer[16];
+        formatTime(seconds, buffer, sizeof(buffer));
+        return buffer;
     }
 }
@@ -0,0 +1,474 @@
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Counts every global new in the process (SFML and the standard library included) for allocs/op
+#ifndef HELLFIRE_TRACK_ALLOCS
+#define HELLFIRE_TRACK_ALLOCS
+#endif
+#include "Game.h"
+#include "MatchEnv.h"
+#include "PerfCounters.h"
+
+// --- bench.cpp ---
+// Microbenchmarks for the simulation and resource hot paths. Every benchmark reports the mean
+// time per operation, the spread between repetitions and heap allocations per operation, so a
+// regression in either speed or allocation behaviour shows up as a number.
+//
+//   ./bench                 run everything
+//   ./bench Hitbox          only benchmarks whose name contains "Hitbox"
+//   ./bench --csv           machine-readable output for tracking runs over time
+//   ./bench --counters      add hardware counters per operation: cycles, IPC, cache and branch
+//                           misses (Linux; needs kernel.perf_event_paranoid <= 2)
+//
+// Pure CPU benchmarks run anywhere. Anything that creates textures (fighters, map frames)
+// needs an OpenGL context, so on a headless Linux box run it under a virtual X server
+// (`make bench-run` uses xvfb-run); without a display those groups are skipped.
+
+// Keeps the optimizer from throwing away a result we only compute to time it
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// --- Harness ---
+struct BenchResult {
+    std::string name;
+    long long iterations = 0;   // Per repetition
+    int repetitions = 0;
+    double meanNs = 0.0;        // Per operation
+    double stddevNs = 0.0;      // Between repetitions
+    double minNs = 0.0;
+    double allocsPerOp = 0.0;
+    bool haveCounters = false;
+    PerfCounters::Values countersPerOp; // Over all timed repetitions, divided per operation
+};
+
+struct BenchOptions {
+    std::string filter;
+    bool csv = false;
+    bool counters = false;
+};
+
+static BenchOptions options;
+static PerfCounters counters; // Open only with --counters
+static std::vector<BenchResult> results;
+
+static const double TARGET_REPETITION_NS = 20e6; // Calibrate each repetition to about 20 ms
+static const int REPETITIONS = 10;
+
+static bool selected(const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+static double elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const BenchResult& r) {
+    results.push_back(r);
+    const double* c = r.countersPerOp.counts;
+    if (options.csv) {
+        std::printf("%s,%lld,%d,%.2f,%.2f,%.2f,%.3f", r.name.c_str(), r.iterations, r.repetitions,
+                    r.meanNs, r.stddevNs, r.minNs, r.allocsPerOp);
+        if (counters.isOpen()) {
+            std::printf(",%.1f,%.1f,%.3f,%.3f,%.3f", c[PerfCounters::CYCLES], c[PerfCounters::INSTRUCTIONS],
+                        r.countersPerOp.ipc(), c[PerfCounters::CACHE_MISSES], c[PerfCounters::BRANCH_MISSES]);
+        }
+        std::printf("\n");
+    } else {
+        double spread = r.meanNs > 0.0 ? 100.0 * r.stddevNs / r.meanNs : 0.0;
+        std::printf("%-40s %10lld x %-2d %14.1f ns/op  +-%5.1f%%  min %14.1f  %8.2f allocs/op\n",
+                    r.name.c_str(), r.iterations, r.repetitions, r.meanNs, spread, r.minNs, r.allocsPerOp);
+        if (r.haveCounters) {
+            std::printf("%-40s %12.1f cycles/op  %5.2f IPC  %10.3f cache misses/op  %8.3f branch misses/op%s\n", "",
+                        c[PerfCounters::CYCLES], r.countersPerOp.ipc(), c[PerfCounters::CACHE_MISSES],
+                        c[PerfCounters::BRANCH_MISSES], r.countersPerOp.multiplexed ? "  (multiplexed)" : "");
+        }
+    }
+    std::fflush(stdout);
+}
+
+// Divides the counts over `operations` and stores them in the result
+static void attachCounters(BenchResult& r, PerfCounters::Values values, double operations) {
+    if (!counters.isOpen()) return;
+    for (double& count : values.counts) count /= operations;
+    r.countersPerOp = values;
+    r.haveCounters = true;
+}
+
+// Runs `body` (one operation per call) in timed repetitions. The iteration count doubles
+// until one repetition takes about TARGET_REPETITION_NS, then REPETITIONS more are timed.
+template <typename Body>
+static void runBenchmark(const std::string& name, Body&& body) {
+    if (!selected(name)) return;
+
+    long long iterations = 1;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; ++i) body();
+        double ns = elapsedNs(start);
+        if (ns >= TARGET_REPETITION_NS || iterations >= (1LL << 30)) break;
+        // Jump most of the way in one step once the timing is meaningful
+        iterations = ns > 1e5 ? std::max(iterations * 2, static_cast<long long>(iterations * TARGET_REPETITION_NS / ns))
+                              : iterations * 2;
+    }
+
+    std::vector<double> samples;
+    unsigned long long allocsBefore = AllocTracker::totalCount.load(std::memory_order_relaxed);
+    counters.start();
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; ++i) body();
+        samples.push_back(elapsedNs(start) / static_cast<double>(iterations));
+    }
+    PerfCounters::Values counts = counters.stop();
+    unsigned long long allocs = AllocTracker::totalCount.load(std::memory_order_relaxed) - allocsBefore;
+
+    BenchResult r;
+    r.name = name;
+    r.iterations = iterations;
+    r.repetitions = REPETITIONS;
+    for (double s : samples) r.meanNs += s;
+    r.meanNs /= samples.size();
+    for (double s : samples) r.stddevNs += (s - r.meanNs) * (s - r.meanNs);
+    r.stddevNs = std::sqrt(r.stddevNs / samples.size());
+    r.minNs = *std::min_element(samples.begin(), samples.end());
+    r.allocsPerOp = static_cast<double>(allocs) / (static_cast<double>(iterations) * REPETITIONS);
+    attachCounters(r, counts, static_cast<double>(iterations) * REPETITIONS);
+    report(r);
+}
+
+// For things that only happen once per process (a cold load): a single timed call, no spread
+template <typename Body>
+static void runOnce(const std::string& name, Body&& body) {
+    if (!selected(name)) return;
+    unsigned long long allocsBefore = AllocTracker::totalCount.load(std::memory_order_relaxed);
+    counters.start();
+    auto start = std::chrono::steady_clock::now();
+    body();
+    double ns = elapsedNs(start);
+    PerfCounters::Values counts = counters.stop();
+    BenchResult r;
+    r.name = name;
+    r.iterations = 1;
+    r.repetitions = 1;
+    r.meanNs = r.minNs = ns;
+    r.allocsPerOp = static_cast<double>(AllocTracker::totalCount.load(std::memory_order_relaxed) - allocsBefore);
+    attachCounters(r, counts, 1.0);
+    report(r);
+}
+
+// --- Fighter benchmarks ---
+static const float TICK = 1.0f / GameConfig::SIMULATION_TICK_RATE;
+
+static const char* actionName(Character::Action action) {
+    switch (action) {
+        case Character::Action::IDLE: return "IDLE";
+        case Character::Action::RUN: return "RUN";
+        case Character::Action::JUMP: return "JUMP";
+        case Character::Action::ATTACK1: return "ATTACK1";
+        case Character::Action::ATTACK2: return "ATTACK2";
+        case Character::Action::ATTACK3: return "ATTACK3";
+        case Character::Action::SHIELD: return "SHIELD";
+        case Character::Action::HURT: return "HURT";
+        case Character::Action::DEAD: return "DEAD";
+    }
+    return "?";
+}
+
+// Puts the fighter back into `action` before each call. Only the flags are reset; the animation
+// clock keeps running so frame advances and wrap-arounds are part of the measurement.
+static void primeAction(Character& fighter, Character::Action action) {
+    fighter.currentAction = action;
+    fighter.isAlive = action != Character::Action::DEAD;
+    fighter.isHurt = action == Character::Action::HURT;
+    fighter.isShielding = action == Character::Action::SHIELD;
+    fighter.isAttacking = action == Character::Action::ATTACK1 || action == Character::Action::ATTACK2 ||
+                          action == Character::Action::ATTACK3;
+    if (action == Character::Action::JUMP && !fighter.isJumping) {
+        fighter.isJumping = true;
+        fighter.verticalVelocity = GameConfig::JUMP_STRENGTH;
+    }
+}
+
+static void benchFighters() {
+    Player player;
+    Enemy enemy;
+    player.setGroundY(GameConfig::WINDOW_HEIGHT * 0.75f);
+    enemy.setGroundY(GameConfig::WINDOW_HEIGHT * 0.75f);
+    player.resetPosition(400.f);
+    enemy.resetPosition(520.f);
+
+    const Character::Action actions[] = {
+        Character::Action::IDLE, Character::Action::RUN, Character::Action::JUMP,
+        Character::Action::ATTACK1, Character::Action::ATTACK2, Character::Action::ATTACK3,
+        Character::Action::SHIELD, Character::Action::HURT, Character::Action::DEAD
+    };
+
+    for (Character::Action action : actions) {
+        runBenchmark(std::string("Character::update/") + actionName(action), [&] {
+            primeAction(player, action);
+            player.Character::update(TICK, GameConfig::WINDOW_WIDTH, &enemy);
+        });
+        runBenchmark(std::string("Character::updateAnimationFrame/") + actionName(action), [&] {
+            primeAction(player, action);
+            player.updateAnimationFrame(TICK);
+        });
+    }
+    player.reset();
+    player.resetPosition(400.f);
+
+    player.isAttacking = true;
+    runBenchmark("Character::getAttackHitbox", [&] {
+        sf::FloatRect box = player.getAttackHitbox();
+        keep(box);
+    });
+    runBenchmark("Character::getHurtbox", [&] {
+        sf::FloatRect box = enemy.getHurtbox();
+        keep(box);
+    });
+
+    // Both directions of the collision check with the player's swing landing every time; health
+    // and the per-swing flag are restored so the hit path runs on every operation
+    runBenchmark("GamePlayScreen::resolveAttack/hit", [&] {
+        player.isAttacking = true;
+        player.dealtDamageThisAttack = false;
+        enemy.reset();
+        bool hit = GamePlayScreen::resolveAttack(player, enemy);
+        hit |= GamePlayScreen::resolveAttack(enemy, player);
+        keep(hit);
+    });
+    // The pixel-precise follow-up on its own, over the fighters' whole overlapping frames (more
+    // rows than any hitbox/hurtbox overlap)
+    sf::FloatRect framesOverlap;
+    player.getBounds().intersects(enemy.getBounds(), framesOverlap);
+    runBenchmark("Character::pixelsOverlap", [&] {
+        bool touching = player.pixelsOverlap(enemy, framesOverlap);
+        keep(touching);
+    });
+    enemy.reset();
+    enemy.resetPosition(1100.f);
+    runBenchmark("GamePlayScreen::resolveAttack/miss", [&] {
+        player.isAttacking = true;
+        player.dealtDamageThisAttack = false;
+        bool hit = GamePlayScreen::resolveAttack(player, enemy);
+        hit |= GamePlayScreen::resolveAttack(enemy, player);
+        keep(hit);
+    });
+}
+
+// --- Tick benchmarks ---
+// One operation is one simulation tick of a match, so counters read directly as "per tick".
+// The fighters start in range of each other: the AI blocks, swings and gets hit, and the
+// player keeps attacking, so most branches of the fighter logic stay in play.
+static void benchTicks() {
+    Player player;
+    Enemy enemy;
+    player.setGroundY(GameConfig::WINDOW_HEIGHT * 0.75f);
+    enemy.setGroundY(GameConfig::WINDOW_HEIGHT * 0.75f);
+
+    // The AI's decision on its own: reaction time of one tick so every call scores the options
+    player.resetPosition(400.f);
+    enemy.resetPosition(520.f);
+    AIProfile everyTick = aiProfile(AIDifficulty::HARD);
+    everyTick.reactionTicks = 1;
+    UtilityAI decider(everyTick);
+    runBenchmark("UtilityAI::decide", [&] {
+        decider.decide(enemy, player, enemy.input);
+        keep(enemy.input);
+    });
+
+    // The Table tier's lookup, deciding every tick like the UtilityAI above (needs policy-run)
+    PolicyTable policy;
+    if (policy.load(GameConfig::AI_POLICY_PATH)) {
+        TableAI table(&policy, everyTick);
+        runBenchmark("TableAI::decide", [&] {
+            table.decide(enemy, player, enemy.input);
+            keep(enemy.input);
+        });
+    }
+
+    // One forward-model tick: the unit SearchAI counts as a node
+    player.reset();
+    enemy.reset();
+    player.resetPosition(400.f);
+    enemy.resetPosition(520.f);
+    const MatchState start = FighterSim::capture(player, enemy);
+    MatchState match = start;
+    FighterInput attack;
+    attack.set(FighterInput::ATTACK1, true);
+    runBenchmark("FighterSim::step", [&] {
+        FighterSim::step(match, attack, attack, TICK);
+        if (!match.fighters[0].alive || !match.fighters[1].alive) match = start;
+        keep(match);
+    });
+
+    // A whole Expert search from the same position, waited for. Nodes/s is what sizes
+    // GameConfig::SEARCH_AI_BUDGET_MS for a machine.
+    AIBudget searchStats;
+    SearchAI search(aiProfile(AIDifficulty::EXPERT), &searchStats);
+    runBenchmark("SearchAI::searchNow", [&] {
+        AIOption option = search.searchNow(start);
+        keep(option);
+    });
+    if (searchStats.searches > 0 && !options.csv) {
+        std::printf("%-40s %14.0f nodes/s on %d threads, average depth %.2f, %llu of %llu cut short\n", "",
+                    searchStats.nodesPerSecond(), search.threadCount(),
+                    static_cast<double>(searchStats.searchDepthSum) / searchStats.searches,
+                    static_cast<unsigned long long>(searchStats.searchesCutShort),
+                    static_cast<unsigned long long>(searchStats.searches));
+    }
+
+    // Everything GamePlayScreen::update does for the fighters in one tick
+    player.reset();
+    enemy.reset();
+    player.resetPosition(400.f);
+    enemy.resetPosition(520.f);
+    UtilityAI ai(aiProfile(AIDifficulty::NORMAL));
+    long long tick = 0;
+    runBenchmark("Tick/fighters+ai+collision", [&] {
+        SimClock::advance(sf::seconds(TICK));
+        player.input = FighterInput();
+        if (tick++ % 40 == 0) player.input.set(FighterInput::ATTACK1, true);
+        if (!player.isAlive) player.reset();
+        if (!enemy.isAlive) enemy.reset();
+        ai.decide(enemy, player, enemy.input);
+        enemy.handlePlayer2Input();
+        player.update(TICK, GameConfig::WINDOW_WIDTH, &enemy);
+        enemy.update(TICK, GameConfig::WINDOW_WIDTH, &player);
+        bool hit = GamePlayScreen::resolveAttack(player, enemy);
+        hit |= GamePlayScreen::resolveAttack(enemy, player);
+        keep(hit);
+    });
+}
+
+// --- Damage text benchmarks ---
+// One operation is one simulation tick of the damage-number list the way GamePlayScreen runs
+// it: a hit every few ticks spawns a label, every label moves, expired labels are erased.
+static void benchDamageTexts() {
+    std::vector<DamageText> damageTexts;
+    long long tick = 0;
+    runBenchmark("DamageText/spawn+update+erase", [&] {
+        if (tick++ % 8 == 0) damageTexts.emplace_back("-12", sf::Color::Yellow, sf::Vector2f(400.f, 300.f));
+        SimClock::advance(sf::seconds(TICK));
+        for (auto it = damageTexts.begin(); it != damageTexts.end(); ) {
+            it->update(TICK);
+            if (it->isExpired()) {
+                it = damageTexts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    });
+}
+
+// A batch of headless training matches; one op is one lockstep step of all of them. Needs no
+// display: the env reads sprite sheet sizes with sf::Image.
+static void benchEnv() {
+    const int count = 256;
+    MatchEnv env(count);
+    env.reset();
+    std::vector<int> actions(count);
+    unsigned int next = 1;
+    runBenchmark("MatchEnv::step/256", [&] {
+        for (int& action : actions) {
+            next = next * 1103515245u + 12345u; // Cheap LCG: the learner presses something new each step
+            action = static_cast<int>((next >> 16) % MatchEnv::ACTION_SIZE);
+        }
+        MatchEnv::StepResult result = env.step(actions.data());
+        keep(result);
+    });
+    if (!options.csv && !results.empty() && results.back().name == "MatchEnv::step/256") {
+        std::printf("%-40s %14.0f env-steps/s on %d threads\n", "", count * 1e9 / results.back().meanNs, env.threadCount());
+    }
+}
+
+// --- Utility and resource benchmarks ---
+static void benchUtils() {
+    float seconds = 0.f;
+    runBenchmark("Utils::formatTime/buffer", [&] {
+        char label[16];
+        int written = Utils::formatTime(seconds, label, sizeof(label));
+        seconds = seconds >= 99.f ? 0.f : seconds + 1.f;
+        keep(written);
+        keep(label);
+    });
+    runBenchmark("Utils::formatTime/string", [&] {
+        std::string label = Utils::formatTime(seconds);
+        seconds = seconds >= 99.f ? 0.f : seconds + 1.f;
+        keep(label);
+    });
+
+    ResourceManager::getFont("ariblk.ttf"); // Load outside the timing; the benchmark is the lookup
+    const std::string fontId = "ariblk.ttf";
+    runBenchmark("ResourceManager::getFont/hit", [&] {
+        sf::Font& font = ResourceManager::getFont(fontId);
+        keep(font);
+    });
+    runBenchmark("ResourceManager::getFont/literal", [&] {
+        sf::Font& font = ResourceManager::getFont("ariblk.ttf");
+        keep(font);
+    });
+}
+
+// Map 2 is the largest set of background frames. "Cold" is the first load in the process
+// (decoder, driver and file cache all untouched); "warm" repeats the same load afterwards.
+static void benchMapLoads() {
+    std::vector<sf::Texture> frames;
+    runOnce("ResourceManager::loadMapFrames/map2/cold", [&] {
+        ResourceManager::loadMapFrames(frames, 20, "", ".png", 1, 6);
+    });
+    runBenchmark("ResourceManager::loadMapFrames/map2/warm", [&] {
+        ResourceManager::loadMapFrames(frames, 20, "", ".png", 1, 6);
+    });
+    ResourceManager::untrackTextures(frames);
+}
+
+static bool hasDisplay() {
+#if defined(__linux__)
+    const char* display = std::getenv("DISPLAY");
+    return display && *display;
+#else
+    return true;
+#endif
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) options.csv = true;
+        else if (std::strcmp(argv[i], "--counters") == 0) options.counters = true;
+        else options.filter = argv[i];
+    }
+    if (options.counters && !counters.open()) {
+        std::fprintf(stderr, "Hardware counters unavailable, timing only: %s\n", counters.error().c_str());
+    }
+    if (options.csv) {
+        std::printf("name,iterations,repetitions,mean_ns,stddev_ns,min_ns,allocs_per_op%s\n",
+                    counters.isOpen() ? ",cycles_per_op,instructions_per_op,ipc,cache_misses_per_op,branch_misses_per_op" : "");
+    }
+
+    // Cold loads have to run before anything else touches PNG decoding
+    bool gl = hasDisplay();
+    if (gl) benchMapLoads();
+
+    benchUtils();
+    benchDamageTexts();
+    benchEnv();
+
+    if (gl) {
+        benchFighters();
+        benchTicks();
+    } else {
+        std::fprintf(stderr, "No display: skipped fighter and texture benchmarks (run under xvfb-run)\n");
+    }
+
+    if (results.empty()) std::fprintf(stderr, "No benchmark matched '%s'\n", options.filter.c_str());
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "BotLink.h"
+#include "MatchEnv.h"
+
+// --- bot_match.cpp ---
+// Headless matches played by a bot in another process over BotLink (shared memory, futex
+// wake-ups). Each match is a MatchEnv env and a BotLink channel; the bot plays the enemy side and
+// the matches step in lockstep: all observations out, all answers back, one step, repeat.
+//
+//   ./bot_match                        serve 1 match on /hellfire_bot until interrupted
+//   ./bot_match --matches 8            one channel per match
+//   ./bot_match --steps 100000         stop after this many lockstep steps (0: run until killed)
+//   ./bot_match --opponent random      scripted player side: idle, random or greedy (default)
+//   ./bot_match --timeout-ms 1000      how long a step waits for an answer before it counts as IDLE
+//   ./bot_match --name /my_segment     segment name
+//   ./bot_match --demo                 fork a built-in bot and report decisions per second
+//
+// The bot attaches with the same segment name, then for each channel waits for an observation
+// newer than the last one it answered and submits an AIOption index for it (see BotLink.h for
+// the layout). Until the first answer arrives the host waits without a timeout, so the bot can
+// be started second.
+
+static volatile sig_atomic_t interrupted = 0;
+
+// The --demo bot: walks in and swings when close, from the observation alone
+static int runDemoBot(const std::string& name, int matches) {
+    BotLink link;
+    for (int attempt = 0; !link.attach(name); ++attempt) {
+        if (attempt > 200) {
+            std::cerr << "demo bot: " << link.error() << std::endl;
+            return 1;
+        }
+        usleep(10000);
+    }
+    std::vector<std::uint32_t> answered(matches, 0);
+    float observation[MatchEnv::OBS_SIZE];
+    for (;;) {
+        for (int i = 0; i < matches; ++i) {
+            float reward = 0.f;
+            std::uint8_t done = 0;
+            std::uint32_t seq = link.waitObservation(i, answered[i], std::chrono::seconds(5), observation, reward, done);
+            if (seq == 0) return 0; // Host gone
+            float reach = std::abs(observation[MatchEnv::OBS_DX]) * GameConfig::WINDOW_WIDTH;
+            AIOption option = reach < 110.f && observation[MatchEnv::OBS_CAN_ATTACK] > 0.5f ? AIOption::ATTACK1 : AIOption::APPROACH;
+            link.submitAction(i, seq, static_cast<int>(option));
+            answered[i] = seq;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string name = GameConfig::BOT_LINK_NAME;
+    MatchEnvConfig config;
+    int matches = 1;
+    long long steps = 0;
+    int timeoutMs = 1000;
+    bool demo = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--matches" && i + 1 < argc) matches = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--steps" && i + 1 < argc) steps = std::atoll(argv[++i]);
+        else if (arg == "--timeout-ms" && i + 1 < argc) timeoutMs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--name" && i + 1 < argc) name = argv[++i];
+        else if (arg == "--demo") demo = true;
+        else if (arg == "--opponent" && i + 1 < argc) {
+            std::string opponent = argv[++i];
+            config.opponent = opponent == "idle" ? EnvOpponent::IDLE : opponent == "random" ? EnvOpponent::RANDOM : EnvOpponent::GREEDY;
+        } else {
+            std::cerr << "Unknown argument " << arg << std::endl;
+            return 2;
+        }
+    }
+    if (demo && steps == 0) steps = 20000;
+
+    BotLink link;
+    if (!link.create(name, matches)) {
+        std::cerr << "Failed to create " << name << ": " << link.error() << std::endl;
+        return 1;
+    }
+
+    // Fork before MatchEnv starts its workers; the child only needs the segment name
+    pid_t bot = -1;
+    if (demo) {
+        bot = fork();
+        if (bot == 0) _exit(runDemoBot(name, matches)); // _exit: the parent owns (and unlinks) the segment
+    }
+    signal(SIGINT, [](int) { interrupted = 1; });
+
+    config.threads = 1; // The bot is the bottleneck; leave it the other cores
+    MatchEnv env(matches, config, 1);
+    const float* observations = env.reset();
+    std::vector<std::uint32_t> seqs(matches);
+    for (int i = 0; i < matches; ++i) seqs[i] = link.publish(i, observations + i * MatchEnv::OBS_SIZE, 0.f, MatchEnv::RUNNING);
+
+    std::cout << "Serving " << matches << " match" << (matches == 1 ? "" : "es") << " on " << name << std::endl;
+    std::vector<int> actions(matches, 0);
+    long long late = 0, decisions = 0;
+    bool attached = false;
+    auto start = std::chrono::steady_clock::now();
+    for (long long step = 0; (steps == 0 || step < steps) && !interrupted; ++step) {
+        for (int i = 0; i < matches; ++i) {
+            // Nobody has answered yet: wait as long as it takes (in slices, so Ctrl-C still works)
+            while (!attached && !interrupted && !link.waitAction(i, seqs[i], std::chrono::milliseconds(200), actions[i])) {}
+            if (!attached) {
+                attached = true;
+                start = std::chrono::steady_clock::now();
+                continue;
+            }
+            if (!link.waitAction(i, seqs[i], std::chrono::milliseconds(timeoutMs), actions[i])) {
+                actions[i] = static_cast<int>(AIOption::IDLE);
+                ++late;
+            }
+        }
+        MatchEnv::StepResult result = env.step(actions.data());
+        for (int i = 0; i < matches; ++i) {
+            seqs[i] = link.publish(i, result.observations + i * MatchEnv::OBS_SIZE, result.rewards[i], result.dones[i]);
+        }
+        decisions += matches;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (bot > 0) {
+        kill(bot, SIGTERM);
+        waitpid(bot, nullptr, 0);
+    }
+    std::printf("%lld decisions in %.2f s: %.0f decisions/s, %lld late, %llu matches finished\n", decisions, seconds,
+                seconds > 0.0 ? decisions / seconds : 0.0, late, static_cast<unsigned long long>(env.episodes.load()));
+    return 0;
+}
@@ -0,0 +1,646 @@
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "Game.h"
+
+// --- e2e.cpp ---
+// Scripted end-to-end run of the real game: boots Game, drives it through a fixed script (menu,
+// name input, character and map selection, a replayed match, game over), records per-frame CPU
+// and GPU times, asset load times and peak RSS, and compares them with a checked-in baseline.
+// Exits non-zero if the script fails or a p95/p99 frame time regresses past the threshold.
+//
+//   ./e2e                              run e2e/smoke.script against e2e/baseline.txt
+//   ./e2e --threshold 25               allowed regression in percent (default 15)
+//   ./e2e --slack-ms 1                 ...and in milliseconds, so sub-millisecond noise can't fail a run (default 0.5)
+//   ./e2e --update-baseline            write this run's numbers as the new baseline (the only way to
+//                                      create one: without it a missing baseline fails with exit code 2)
+//   ./e2e --record e2e/new.replay      play normally; the match's inputs are saved for replay
+//   ./e2e --assert-no-alloc [ticks]    fail if a match tick allocates after the first `ticks` (default 120);
+//                                      needs a HELLFIRE_TRACK_ALLOCS build (make e2e-alloc)
+//
+// On a headless Linux box run it under a virtual X server with Mesa's software renderer,
+// e.g. `LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a -s "-screen 0 1280x720x24" ./e2e` (make e2e-run).
+// Baselines are only comparable on the same machine and renderer.
+//
+// Script commands, one per line (# starts a comment):
+//   wait <STATE> [seconds]   until the screen is STATE (e.g. GAME_PLAY) and no fade is running
+//   key <name>               press and release Enter, Escape, Space, Backspace, F2, F3 or F4
+//   type <text>              text entry, one character at a time
+//   click <target>           name_box, pva, pvp, knight, rogue, samurai, map1..map3, restart,
+//                            menu, or "x y" in game (1280x720) coordinates
+//   frames <n>               let n frames be presented (idle menus only redraw on demand)
+//   sleep <seconds>          let the game run on its own for a while
+//   replay <file>            fighter input for the next match, tick by tick (see e2e/match.replay)
+//   quit                     close the window, which ends the run
+//
+// Replay files hold "<ticks> <p1> <p2>" lines: hold these buttons for that many simulation ticks.
+// Buttons are LEFT RIGHT JUMP RUN SHIELD ATTACK1 ATTACK2 ATTACK3 joined with '+', or '-' for none.
+
+// --- Replay ---
+struct ReplaySegment {
+    int ticks = 0;
+    FighterInput player1, player2;
+};
+
+static const char* BUTTON_NAMES[] = { "LEFT", "RIGHT", "JUMP", "RUN", "SHIELD", "ATTACK1", "ATTACK2", "ATTACK3" };
+
+static bool parseButtons(const std::string& text, FighterInput& input) {
+    input = FighterInput();
+    if (text == "-") return true;
+    std::stringstream names(text);
+    std::string name;
+    while (std::getline(names, name, '+')) {
+        bool known = false;
+        for (int bit = 0; bit < 8; ++bit) {
+            if (name == BUTTON_NAMES[bit]) {
+                input.buttons |= static_cast<std::uint16_t>(1 << bit);
+                known = true;
+            }
+        }
+        if (!known) return false;
+    }
+    return true;
+}
+
+static std::string formatButtons(const FighterInput& input) {
+    std::string text;
+    for (int bit = 0; bit < 8; ++bit) {
+        if (!(input.buttons & (1 << bit))) continue;
+        if (!text.empty()) text += '+';
+        text += BUTTON_NAMES[bit];
+    }
+    return text.empty() ? "-" : text;
+}
+
+static bool loadReplay(const std::string& path, std::vector<ReplaySegment>& segments) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open replay " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::stringstream fields(line);
+        std::string p1, p2;
+        ReplaySegment segment;
+        if (!(fields >> segment.ticks)) continue; // Blank or comment
+        if (!(fields >> p1 >> p2) || segment.ticks <= 0 ||
+            !parseButtons(p1, segment.player1) || !parseButtons(p2, segment.player2)) {
+            std::cerr << path << ":" << lineNumber << ": expected \"<ticks> <p1 buttons> <p2 buttons>\"" << std::endl;
+            return false;
+        }
+        segments.push_back(segment);
+    }
+    return true;
+}
+
+// --- Script ---
+struct ScriptStep {
+    enum Kind { WAIT, KEY, TYPE, CLICK, FRAMES, SLEEP, REPLAY, QUIT } kind;
+    std::string arg;
+    GameStateID state = GameStateID::MENU;
+    float timeout = 30.f; // wait: seconds before the run fails; sleep: how long to sleep
+    sf::Keyboard::Key key = sf::Keyboard::Unknown;
+    int count = 0;
+    int line = 0;
+    std::vector<ReplaySegment> replay;
+};
+
+static bool parseState(const std::string& name, GameStateID& state) {
+    for (int i = 0; i <= static_cast<int>(GameStateID::GAME_OVER); ++i) {
+        if (name == FlightRecorder::stateName(static_cast<GameStateID>(i))) {
+            state = static_cast<GameStateID>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseKey(const std::string& name, sf::Keyboard::Key& key) {
+    static const std::map<std::string, sf::Keyboard::Key> keys = {
+        { "Enter", sf::Keyboard::Enter }, { "Escape", sf::Keyboard::Escape }, { "Space", sf::Keyboard::Space },
+        { "Backspace", sf::Keyboard::Backspace }, { "F2", sf::Keyboard::F2 }, { "F3", sf::Keyboard::F3 },
+        { "F4", sf::Keyboard::F4 }
+    };
+    auto it = keys.find(name);
+    if (it == keys.end()) return false;
+    key = it->second;
+    return true;
+}
+
+static bool loadScript(const std::string& path, std::vector<ScriptStep>& steps) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Cannot open script " << path << std::endl;
+        return false;
+    }
+    std::string baseDir = path.find('/') == std::string::npos ? "" : path.substr(0, path.rfind('/') + 1);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::stringstream fields(line);
+        std::string command;
+        if (!(fields >> command)) continue;
+
+        ScriptStep step;
+        step.line = lineNumber;
+        std::getline(fields >> std::ws, step.arg);
+        while (!step.arg.empty() && (step.arg.back() == ' ' || step.arg.back() == '\r')) step.arg.pop_back();
+        std::stringstream args(step.arg);
+        bool ok = true;
+
+        if (command == "wait") {
+            step.kind = ScriptStep::WAIT;
+            std::string state;
+            ok = (args >> state) && parseState(state, step.state);
+            if (ok && !(args >> step.timeout)) step.timeout = 30.f;
+        } else if (command == "key") {
+            step.kind = ScriptStep::KEY;
+            ok = parseKey(step.arg, step.key);
+        } else if (command == "type") {
+            step.kind = ScriptStep::TYPE;
+        } else if (command == "click") {
+            step.kind = ScriptStep::CLICK;
+            ok = !step.arg.empty();
+        } else if (command == "frames") {
+            step.kind = ScriptStep::FRAMES;
+            ok = (args >> step.count) && step.count > 0;
+        } else if (command == "sleep") {
+            step.kind = ScriptStep::SLEEP;
+            ok = (args >> step.timeout) && step.timeout >= 0.f;
+        } else if (command == "replay") {
+            step.kind = ScriptStep::REPLAY;
+            ok = loadReplay(baseDir + step.arg, step.replay);
+        } else if (command == "quit") {
+            step.kind = ScriptStep::QUIT;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << path << ":" << lineNumber << ": cannot parse \"" << line << "\"" << std::endl;
+            return false;
+        }
+        steps.push_back(step);
+    }
+    return true;
+}
+
+// --- Scripted driver ---
+// Runs the script from the render thread (between frames, under simMutex) and feeds the match
+// its replayed input from the simulation thread. Replay ticks only advance while the match is
+// live, so the fight plays out the same however long loading or rendering takes.
+class ScriptedDriver : public GameDriver {
+public:
+    struct FrameSample {
+        GameStateID state;
+        bool transition;
+        float cpuMs, gpuMs, frameMs;
+        std::uint64_t allocations; // Render thread heap allocations for the frame
+    };
+
+    std::vector<FrameSample> frames; // Render thread
+    bool failed = false;
+    std::string failure;
+    int allocWarmupTicks = -1;          // Live match ticks allowed to allocate; negative turns the check off
+    std::uint64_t worstTickAllocations = 0; // Most heap allocations in one steady-state match tick
+
+    ScriptedDriver(Game& owner, std::vector<ScriptStep> scriptSteps, const std::string& recordTo)
+        : game(owner), steps(std::move(scriptSteps)), recordPath(recordTo) {
+        frames.reserve(1 << 16);
+    }
+
+    void injectEvents(std::vector<sf::Event>& events) override {
+        if (allocFailureTick >= 0 && !failed) {
+            failed = true;
+            failure = "match tick " + std::to_string(allocFailureTick) + " made " + std::to_string(allocFailure.count) +
+                      " heap allocation(s), " + std::to_string(allocFailure.bytes) + " bytes (see the per-scope totals above)";
+            sf::Event closed;
+            closed.type = sf::Event::Closed;
+            events.push_back(closed);
+        }
+        while (nextStep < steps.size() && !failed) {
+            ScriptStep& step = steps[nextStep];
+            if (!stepStarted) {
+                stepStarted = true;
+                stepClock.restart();
+                stepFrames = presentedFrames;
+            }
+            if (!runStep(step, events)) break; // Still waiting
+            ++nextStep;
+            stepStarted = false;
+        }
+    }
+
+    void sampleInput(FighterInput& player1, FighterInput& player2) override {
+        bool live = game.currentStateID == GameStateID::GAME_PLAY && game.currentTransition == TransitionState::NONE;
+        player1 = FighterInput();
+        player2 = FighterInput();
+        checkTickAllocations(live);
+
+        if (!recordPath.empty()) {
+            player1 = Input::sampleKeyboardP1();
+            if (game.enemy.isPlayerControlled) player2 = Input::sampleKeyboardP2();
+            if (live) record(player1, player2);
+            return;
+        }
+        if (!live || replaySegment >= replay.size()) return;
+
+        player1 = replay[replaySegment].player1;
+        player2 = replay[replaySegment].player2;
+        if (++replayTick >= replay[replaySegment].ticks) {
+            ++replaySegment;
+            replayTick = 0;
+        }
+    }
+
+    void framePresented(const PerfOverlay::Sample& sample) override {
+        ++presentedFrames;
+        auto ms = [](sf::Time t) { return t.asMicroseconds() / 1000.f; };
+        FrameSample frame;
+        frame.state = game.currentStateID; // Read without the lock: only used to label the frame
+        frame.transition = game.currentTransition != TransitionState::NONE;
+        frame.cpuMs = ms(sample.events + sample.render);
+        frame.gpuMs = ms(sample.gpu);
+        frame.frameMs = ms(sample.frame);
+        frame.allocations = sample.frameAllocations.count;
+        frames.push_back(frame);
+    }
+
+    bool scriptFinished() const { return nextStep >= steps.size(); }
+
+    bool saveRecording() const {
+        if (recordPath.empty()) return true;
+        std::ofstream out(recordPath);
+        out << "# Recorded match input: <ticks> <player 1 buttons> <player 2 buttons>\n";
+        for (const ReplaySegment& segment : recorded) {
+            out << segment.ticks << " " << formatButtons(segment.player1) << " " << formatButtons(segment.player2) << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+private:
+    Game& game;
+    std::vector<ScriptStep> steps;
+    std::size_t nextStep = 0;
+    bool stepStarted = false;
+    sf::Clock stepClock;
+    std::size_t stepFrames = 0;
+    std::size_t presentedFrames = 0;
+
+    // Simulation thread (set up by the script under simMutex)
+    std::vector<ReplaySegment> replay;
+    std::size_t replaySegment = 0;
+    int replayTick = 0;
+
+    std::string recordPath;
+    std::vector<ReplaySegment> recorded;
+
+    // Simulation thread; the failure is reported from the render thread, which can safely close the window
+    bool previousTickLive = false;
+    int liveTicks = 0;
+    int allocFailureTick = -1;
+    AllocTracker::Counters allocFailure;
+
+    // Game::lastTickAllocations still holds the tick before this one. It only counts if the match was
+    // live both before and after it, so the ticks that start or end the match are left out.
+    void checkTickAllocations(bool live) {
+        if (previousTickLive && live) {
+            ++liveTicks;
+            const AllocTracker::Counters& tick = game.lastTickAllocations;
+            if (liveTicks > std::max(allocWarmupTicks, 0)) worstTickAllocations = std::max(worstTickAllocations, tick.count);
+            if (allocWarmupTicks >= 0 && liveTicks > allocWarmupTicks && tick.count > 0 && allocFailureTick < 0) {
+                allocFailureTick = liveTicks;
+                allocFailure = tick;
+            }
+        }
+        previousTickLive = live;
+    }
+
+    void fail(const ScriptStep& step, const std::string& why, std::vector<sf::Event>& events) {
+        failed = true;
+        failure = "script line " + std::to_string(step.line) + ": " + why;
+        sf::Event closed;
+        closed.type = sf::Event::Closed;
+        events.push_back(closed);
+    }
+
+    // Returns true once the step is done
+    bool runStep(ScriptStep& step, std::vector<sf::Event>& events) {
+        switch (step.kind) {
+            case ScriptStep::WAIT:
+                if (game.currentStateID == step.state && game.currentTransition == TransitionState::NONE) return true;
+                if (stepClock.getElapsedTime().asSeconds() > step.timeout) {
+                    fail(step, std::string("timed out waiting for ") + FlightRecorder::stateName(step.state) +
+                               " (on " + FlightRecorder::stateName(game.currentStateID) + ")", events);
+                }
+                return false;
+
+            case ScriptStep::KEY: {
+                sf::Event event;
+                event.type = sf::Event::KeyPressed;
+                event.key.code = step.key;
+                event.key.alt = event.key.control = event.key.shift = event.key.system = false;
+                events.push_back(event);
+                event.type = sf::Event::KeyReleased;
+                events.push_back(event);
+                return true;
+            }
+
+            case ScriptStep::TYPE:
+                for (char c : step.arg) {
+                    sf::Event event;
+                    event.type = sf::Event::TextEntered;
+                    event.text.unicode = static_cast<sf::Uint32>(static_cast<unsigned char>(c));
+                    events.push_back(event);
+                }
+                return true;
+
+            case ScriptStep::CLICK: {
+                sf::Vector2f target;
+                if (!resolveTarget(step.arg, target)) {
+                    fail(step, "unknown click target \"" + step.arg + "\"", events);
+                    return false;
+                }
+                // Screens map clicks through the window's current (letterboxed) view
+                sf::Vector2i pixel = game.window.mapCoordsToPixel(target, game.window.getView());
+                sf::Event event;
+                event.type = sf::Event::MouseButtonPressed;
+                event.mouseButton.button = sf::Mouse::Left;
+                event.mouseButton.x = pixel.x;
+                event.mouseButton.y = pixel.y;
+                events.push_back(event);
+                event.type = sf::Event::MouseButtonReleased;
+                events.push_back(event);
+                return true;
+            }
+
+            case ScriptStep::FRAMES:
+                return presentedFrames - stepFrames >= static_cast<std::size_t>(step.count);
+
+            case ScriptStep::SLEEP:
+                return stepClock.getElapsedTime().asSeconds() >= step.timeout;
+
+            case ScriptStep::REPLAY:
+                replay = step.replay;
+                replaySegment = 0;
+                replayTick = 0;
+                return true;
+
+            case ScriptStep::QUIT: {
+                sf::Event closed;
+                closed.type = sf::Event::Closed;
+                events.push_back(closed);
+                return true;
+            }
+        }
+        return true;
+    }
+
+    template <typename ScreenType>
+    ScreenType* screen(GameStateID id) {
+        return dynamic_cast<ScreenType*>(game.screens[id].get());
+    }
+
+    static sf::Vector2f centerOf(const sf::Shape& shape) {
+        sf::FloatRect bounds = shape.getGlobalBounds();
+        return sf::Vector2f(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+    }
+
+    // Named widgets are looked up on their screens, so the script survives layout changes
+    bool resolveTarget(const std::string& name, sf::Vector2f& target) {
+        std::stringstream coords(name);
+        if (coords >> target.x >> target.y) return true;
+
+        auto* nameInput = screen<NameInputScreen>(GameStateID::NAME_INPUT);
+        auto* modeSelect = screen<ModeSelectionScreen>(GameStateID::MODE_SELECTION);
+        auto* charSelect = screen<CharacterSelectionScreen>(GameStateID::CHARACTER_SELECTION);
+        auto* mapSelect = screen<MapSelectionScreen>(GameStateID::MAP_SELECTION);
+        auto* gameOver = screen<GameOverScreen>(GameStateID::GAME_OVER);
+
+        if (name == "name_box" && nameInput) target = centerOf(nameInput->inputBox);
+        else if (name == "pva" && modeSelect) target = centerOf(modeSelect->pvaButton);
+        else if (name == "pvp" && modeSelect) target = centerOf(modeSelect->pvpButton);
+        else if (name == "knight" && charSelect) target = centerOf(charSelect->char1Frame);
+        else if (name == "rogue" && charSelect) target = centerOf(charSelect->char2Frame);
+        else if (name == "samurai" && charSelect) target = centerOf(charSelect->char3Frame);
+        else if (name == "map1" && mapSelect) target = centerOf(mapSelect->map1Frame);
+        else if (name == "map2" && mapSelect) target = centerOf(mapSelect->map2Frame);
+        else if (name == "map3" && mapSelect) target = centerOf(mapSelect->map3Frame);
+        else if (name == "restart" && gameOver) target = centerOf(gameOver->restartButton);
+        else if (name == "menu" && gameOver) target = centerOf(gameOver->menuButtonShape);
+        else return false;
+        return true;
+    }
+
+    void record(const FighterInput& player1, const FighterInput& player2) {
+        if (!recorded.empty() && recorded.back().player1.buttons == player1.buttons &&
+            recorded.back().player2.buttons == player2.buttons) {
+            ++recorded.back().ticks;
+            return;
+        }
+        ReplaySegment segment;
+        segment.ticks = 1;
+        segment.player1 = player1;
+        segment.player2 = player2;
+        recorded.push_back(segment);
+    }
+};
+
+// --- Report ---
+static float percentile(std::vector<float> values, float p) {
+    if (values.empty()) return 0.f;
+    std::sort(values.begin(), values.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.f * values.size()));
+    return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+typedef std::map<std::string, double> Metrics;
+
+static bool loadBaseline(const std::string& path, Metrics& baseline) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+        std::stringstream fields(line);
+        std::string key;
+        double value;
+        if (fields >> key >> value) baseline[key] = value;
+    }
+    return true;
+}
+
+static bool saveBaseline(const std::string& path, const Metrics& metrics) {
+    std::ofstream out(path);
+    out << "# e2e baseline: regenerate with ./e2e --update-baseline on the reference machine\n";
+    for (const auto& entry : metrics) out << entry.first << " " << entry.second << "\n";
+    return static_cast<bool>(out);
+}
+
+// Gated metrics fail the run when they regress past the threshold; the rest are reported only
+static bool isGated(const std::string& key) {
+    return key.find("_p95_ms") != std::string::npos || key.find("_p99_ms") != std::string::npos;
+}
+
+int main(int argc, char** argv) {
+    std::string scriptPath = "e2e/smoke.script";
+    std::string baselinePath = "e2e/baseline.txt";
+    std::string recordPath;
+    float thresholdPercent = 15.f;
+    float slackMs = 0.5f;
+    bool updateBaseline = false;
+    int allocWarmupTicks = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threshold" && i + 1 < argc) thresholdPercent = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--slack-ms" && i + 1 < argc) slackMs = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--baseline" && i + 1 < argc) baselinePath = argv[++i];
+        else if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--update-baseline") updateBaseline = true;
+        else if (arg == "--assert-no-alloc") {
+            allocWarmupTicks = 120;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) allocWarmupTicks = std::atoi(argv[++i]);
+        }
+        else scriptPath = arg;
+    }
+
+    if (allocWarmupTicks >= 0 && !AllocTracker::enabled) {
+        std::cerr << "--assert-no-alloc needs a build with -DHELLFIRE_TRACK_ALLOCS (make e2e-alloc)" << std::endl;
+        return 2;
+    }
+
+    std::vector<ScriptStep> steps;
+    if (recordPath.empty() && !loadScript(scriptPath, steps)) return 2;
+
+    Utils::rng.seed(1); // Damage-number drift and shake offsets come out the same every run
+    std::int64_t runStartUs = FlightRecorder::nowUs();
+
+    Game game;
+    ScriptedDriver driver(game, steps, recordPath);
+    game.driver = &driver;
+    driver.allocWarmupTicks = allocWarmupTicks;
+    game.measureGpuTime = recordPath.empty();
+    game.framePacer.mode = PacingMode::LIMITER; // No vblank under a virtual X server: pace to FRAMERATE_LIMIT instead
+    game.framePacer.apply(game.window);
+    game.run();
+
+    if (!recordPath.empty()) {
+        if (!driver.saveRecording()) {
+            std::cerr << "Failed to write " << recordPath << std::endl;
+            return 2;
+        }
+        std::cout << "Match input written to " << recordPath << std::endl;
+        return 0;
+    }
+
+    if (!driver.failed && !driver.scriptFinished()) {
+        driver.failed = true;
+        driver.failure = "window closed before the script finished";
+    }
+
+    // --- Measurements ---
+    std::vector<float> cpu, gpu, matchFrame;
+    std::uint64_t worstFrameAllocations = 0;
+    for (const ScriptedDriver::FrameSample& frame : driver.frames) {
+        cpu.push_back(frame.cpuMs);
+        gpu.push_back(frame.gpuMs);
+        // Menus redraw only on demand, so present-to-present time means something only in the match
+        if (frame.state == GameStateID::GAME_PLAY && !frame.transition) {
+            matchFrame.push_back(frame.frameMs);
+            worstFrameAllocations = std::max(worstFrameAllocations, frame.allocations);
+        }
+    }
+
+    std::map<std::string, double> loadMs;
+    double loadTotalMs = 0.0, loadWorstMs = 0.0;
+    for (const FlightRecorder::AssetRecord& load : FlightRecorder::global().assetsSince(runStartUs)) {
+        loadMs[load.name] += load.durationMs;
+        loadTotalMs += load.durationMs;
+        loadWorstMs = std::max(loadWorstMs, static_cast<double>(load.durationMs));
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double peakRssMb = usage.ru_maxrss / 1024.0; // Kilobytes on Linux
+
+    Metrics metrics;
+    metrics["frames"] = static_cast<double>(driver.frames.size());
+    metrics["cpu_p50_ms"] = percentile(cpu, 50);
+    metrics["cpu_p95_ms"] = percentile(cpu, 95);
+    metrics["cpu_p99_ms"] = percentile(cpu, 99);
+    metrics["gpu_p50_ms"] = percentile(gpu, 50);
+    metrics["gpu_p95_ms"] = percentile(gpu, 95);
+    metrics["gpu_p99_ms"] = percentile(gpu, 99);
+    metrics["match_frame_p50_ms"] = percentile(matchFrame, 50);
+    metrics["match_frame_p95_ms"] = percentile(matchFrame, 95);
+    metrics["match_frame_p99_ms"] = percentile(matchFrame, 99);
+    metrics["load_total_ms"] = loadTotalMs;
+    metrics["load_worst_ms"] = loadWorstMs;
+    for (const auto& entry : loadMs) metrics["load_" + entry.first + "_ms"] = entry.second;
+    metrics["peak_rss_mb"] = peakRssMb;
+    if (AllocTracker::enabled) {
+        metrics["match_frame_allocs_max"] = static_cast<double>(worstFrameAllocations);
+        metrics["match_tick_allocs_max"] = static_cast<double>(driver.worstTickAllocations);
+    }
+
+    if (driver.failed) {
+        std::cerr << "FAIL: " << driver.failure << std::endl;
+        return 1;
+    }
+
+    // --- Compare ---
+    Metrics baseline;
+    bool haveBaseline = loadBaseline(baselinePath, baseline);
+    int regressions = 0;
+    std::printf("%-28s %12s %12s %9s\n", "metric", "run", "baseline", "change");
+    for (const auto& entry : metrics) {
+        auto base = baseline.find(entry.first);
+        if (base == baseline.end() || base->second <= 0.0) {
+            std::printf("%-28s %12.2f %12s %9s\n", entry.first.c_str(), entry.second, "-", "");
+            continue;
+        }
+        double change = 100.0 * (entry.second - base->second) / base->second;
+        bool regressed = isGated(entry.first) && change > thresholdPercent && entry.second - base->second > slackMs;
+        if (regressed) ++regressions;
+        std::printf("%-28s %12.2f %12.2f %+8.1f%%%s\n", entry.first.c_str(), entry.second, base->second, change,
+                    regressed ? "  REGRESSION" : "");
+    }
+
+    if (updateBaseline) {
+        if (!saveBaseline(baselinePath, metrics)) {
+            std::cerr << "Failed to write " << baselinePath << std::endl;
+            return 2;
+        }
+        std::cout << (haveBaseline ? "Baseline updated: " : "Baseline created: ") << baselinePath << std::endl;
+        return 0;
+    }
+    // A missing baseline is an error, not a free pass: otherwise a fresh checkout (or a typo in
+    // --baseline) would record itself and the gate could never fail
+    if (!haveBaseline) {
+        std::cerr << "FAIL: no baseline at " << baselinePath << "; run with --update-baseline to create one" << std::endl;
+        return 2;
+    }
+    if (regressions > 0) {
+        std::cerr << "FAIL: " << regressions << " frame-time percentile(s) regressed more than " << thresholdPercent << "%" << std::endl;
+        return 1;
+    }
+    std::cout << "PASS (threshold " << thresholdPercent << "%)" << std::endl;
+    return 0;
+}
@@ -10,7 +10,7 @@ std::map<std::string, sf::Texture> textures;
 
 
 // --- main.cpp ---
-int main() {
+int main(int argc, char** argv) {
     sf::Music backgroundMusic;
     if (!backgroundMusic.openFromFile("assets/hellfire_music.ogg")) {
         return -1;
@@ -21,6 +21,9 @@ int main() {
     backgroundMusic.play();
 
     Game game; // Create the game instance
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--report") game.consoleReport = true; // Stats on stdout (see Game::consoleReport)
+    }
     game.run(); // Start the game loop
     return 0;
 }
\ No newline at end of file
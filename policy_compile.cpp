@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FighterSim.h"
+#include "PolicyTable.h"
+#include "SearchAI.h"
+
+// --- policy_compile.cpp ---
+// Builds the Table difficulty's policy (assets/ai_policy.bin) from self-play in FighterSim.
+//
+//   ./policy_compile                       3 rounds, 200000 scored situations each
+//   ./policy_compile --rounds 5 --samples 500000 --seed 7 --threads 4 --out assets/ai_policy.bin
+//
+// Each round plays matches between two copies of the current policy (the greedy rollout policy
+// before the first table exists), with some random exploration so every option gets seen. Every
+// few ticks one side's situation is scored: each option is held for a moment from a copy of the
+// match, then both sides play the current policy for a while, and the health swing (plus the
+// knockout, if any) is that option's value in that cell. The new table keeps the best average per
+// cell; cells self-play never reached borrow from the nearest distance band that was reached.
+// After each round the table plays the greedy policy from both sides; self-play can wander, so
+// the round with the best record is the one written out.
+//
+// Runs headless: character models come from the presets via sf::Image. Rebuild the table whenever
+// the match rules, the presets or PolicyTable's binning change (load() refuses other binnings).
+
+static const int DECISION_TICKS = 4;    // Matches the Table profile's reactionTicks
+static const int HOLD_TICKS = 6;        // How long the option being scored is held
+static const int ROLLOUT_TICKS = 60;    // Then both sides play on for this long before scoring
+static const int SAMPLE_INTERVAL = 6;   // Ticks between scored situations in a self-play match
+static const int MATCH_TICKS = 1800;    // Self-play matches are cut off here for variety
+static const float EXPLORATION = 0.25f; // Chance a self-play decision is a random option
+
+struct Controller {
+    AIOption held = AIOption::IDLE;
+    int ticksLeft = 0;
+};
+
+struct Compiler {
+    PolicyTable table;
+    FighterModel models[PolicyTable::CHARACTERS];
+
+    AIOption policy(const MatchState& match, int side) const {
+        if (!table.isLoaded()) return SearchAI::greedy(match, side);
+        return table.lookup(PolicyTable::cell(match, side));
+    }
+
+    FighterInput control(const MatchState& match, int side, Controller& c, std::mt19937& rng, float exploration,
+                         bool greedySide = false) const {
+        if (--c.ticksLeft <= 0) {
+            std::uniform_real_distribution<float> roll(0.f, 1.f);
+            if (exploration > 0.f && roll(rng) < exploration) {
+                c.held = static_cast<AIOption>(std::uniform_int_distribution<int>(0, AI_OPTION_COUNT - 1)(rng));
+            } else {
+                c.held = greedySide ? SearchAI::greedy(match, side) : policy(match, side);
+            }
+            c.ticksLeft = DECISION_TICKS;
+        }
+        float dx = SearchAI::offset(match, side);
+        FighterInput input;
+        pressOption(c.held, dx, match.fighters[side].facingRight == (dx >= 0.f), input);
+        return input;
+    }
+
+    static void stepBoth(MatchState& match, const FighterInput (&inputs)[2]) {
+        FighterSim::step(match, inputs[0], inputs[1], 1.0f / GameConfig::SIMULATION_TICK_RATE);
+    }
+
+    static bool over(const MatchState& match) { return !match.fighters[0].alive || !match.fighters[1].alive; }
+
+    // `option` for `side`, held for HOLD_TICKS from `match`, then both sides on the current policy
+    float score(MatchState match, int side, AIOption option, std::mt19937& rng) const {
+        float before = match.fighters[side].health - match.fighters[1 - side].health;
+        Controller controllers[2];
+        controllers[side].held = option;
+        controllers[side].ticksLeft = HOLD_TICKS;
+        for (int t = 0; t < HOLD_TICKS + ROLLOUT_TICKS && !over(match); ++t) {
+            FighterInput inputs[2];
+            for (int s = 0; s < 2; ++s) inputs[s] = control(match, s, controllers[s], rng, 0.f);
+            stepBoth(match, inputs);
+        }
+        float value = ((match.fighters[side].health - match.fighters[1 - side].health) - before) / GameConfig::MAX_HEALTH;
+        if (!match.fighters[1 - side].alive) value += 1.f;
+        if (!match.fighters[side].alive) value -= 1.f;
+        return value;
+    }
+
+    MatchState newMatch(std::mt19937& rng) const {
+        std::uniform_int_distribution<int> character(0, PolicyTable::CHARACTERS - 1);
+        std::uniform_real_distribution<float> jitter(-120.f, 120.f);
+        MatchState match;
+        match.models[0] = models[character(rng)];
+        match.models[1] = models[character(rng)];
+        float groundY = GameConfig::WINDOW_HEIGHT - (match.models[0].frameHeight * match.models[0].scale) - 20;
+        match.models[0].groundY = match.models[1].groundY = groundY;
+        match.fighters[0] = FighterState::spawn(match.models[0], GameConfig::WINDOW_WIDTH * 0.25f + jitter(rng), true);
+        match.fighters[1] = FighterState::spawn(match.models[1], GameConfig::WINDOW_WIDTH * 0.75f + jitter(rng), false);
+        return match;
+    }
+
+    // Self-play until `samples` situations are scored into sums/counts (one worker's share)
+    void selfPlay(long long samples, std::uint32_t seed, std::vector<float>& sums, std::vector<std::uint32_t>& counts) const {
+        std::mt19937 rng(seed);
+        long long scored = 0;
+        while (scored < samples) {
+            MatchState match = newMatch(rng);
+            Controller controllers[2];
+            for (int t = 0; t < MATCH_TICKS && !over(match) && scored < samples; ++t) {
+                if (t % SAMPLE_INTERVAL == 0) {
+                    int side = static_cast<int>(rng() & 1u);
+                    int index = PolicyTable::cell(match, side);
+                    for (int o = 0; o < AI_OPTION_COUNT; ++o) {
+                        sums[index * AI_OPTION_COUNT + o] += score(match, side, static_cast<AIOption>(o), rng);
+                        ++counts[index * AI_OPTION_COUNT + o];
+                    }
+                    ++scored;
+                }
+                FighterInput inputs[2];
+                for (int s = 0; s < 2; ++s) inputs[s] = control(match, s, controllers[s], rng, EXPLORATION);
+                stepBoth(match, inputs);
+            }
+        }
+    }
+
+    // Best average per reached cell; unreached cells copy the nearest reached distance band
+    int rebuild(const std::vector<float>& sums, const std::vector<std::uint32_t>& counts) {
+        // Ties (common where nothing can happen within the rollout) go to the more forward option
+        static const AIOption preference[AI_OPTION_COUNT] = {
+            AIOption::APPROACH, AIOption::ATTACK1, AIOption::ATTACK2, AIOption::ATTACK3,
+            AIOption::IDLE, AIOption::BLOCK, AIOption::JUMP, AIOption::RETREAT
+        };
+        std::vector<std::uint8_t> cells(PolicyTable::CELLS, 0xFF);
+        int reached = 0;
+        for (int index = 0; index < PolicyTable::CELLS; ++index) {
+            if (counts[index * AI_OPTION_COUNT] == 0) continue;
+            float best = -1e9f;
+            for (AIOption option : preference) {
+                int o = static_cast<int>(option);
+                float mean = sums[index * AI_OPTION_COUNT + o] / counts[index * AI_OPTION_COUNT + o];
+                if (mean > best + 1e-6f) {
+                    best = mean;
+                    cells[index] = static_cast<std::uint8_t>(option);
+                }
+            }
+            ++reached;
+        }
+        // Distance is the innermost dimension, so each run of DISTANCE_BINS cells is one situation
+        // at every distance
+        for (int row = 0; row < PolicyTable::CELLS; row += PolicyTable::DISTANCE_BINS) {
+            for (int d = 0; d < PolicyTable::DISTANCE_BINS; ++d) {
+                if (cells[row + d] != 0xFF) continue;
+                std::uint8_t fill = 0xFF;
+                for (int step = 1; step < PolicyTable::DISTANCE_BINS && fill == 0xFF; ++step) {
+                    if (d - step >= 0 && cells[row + d - step] != 0xFF) fill = cells[row + d - step];
+                    else if (d + step < PolicyTable::DISTANCE_BINS && cells[row + d + step] != 0xFF) fill = cells[row + d + step];
+                }
+                if (fill == 0xFF) {
+                    fill = table.isLoaded() ? table.cells[row + d] : static_cast<std::uint8_t>(AIOption::APPROACH);
+                }
+                cells[row + d] = fill;
+            }
+        }
+        table.cells.swap(cells);
+        return reached;
+    }
+
+    // Table against greedy, `matches` from each side; returns wins, losses and draws for the table
+    void evaluate(int matches, std::uint32_t seed, int& wins, int& losses, int& draws) const {
+        std::mt19937 rng(seed);
+        wins = losses = draws = 0;
+        for (int m = 0; m < matches * 2; ++m) {
+            int tableSide = m % 2;
+            MatchState match = newMatch(rng);
+            Controller controllers[2];
+            int roundTicks = static_cast<int>(GameConfig::GAME_ROUND_DURATION * GameConfig::SIMULATION_TICK_RATE);
+            for (int t = 0; t < roundTicks && !over(match); ++t) {
+                FighterInput inputs[2];
+                for (int s = 0; s < 2; ++s) inputs[s] = control(match, s, controllers[s], rng, 0.f, s != tableSide);
+                stepBoth(match, inputs);
+            }
+            float margin = match.fighters[tableSide].health - match.fighters[1 - tableSide].health;
+            if (margin > 0.f) ++wins;
+            else if (margin < 0.f) ++losses;
+            else ++draws;
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    int rounds = 3;
+    long long samples = 200000;
+    std::uint32_t seed = 1;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    std::string outPath = "assets/ai_policy.bin";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) rounds = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--samples" && i + 1 < argc) samples = std::max(1LL, std::atoll(argv[++i]));
+        else if (arg == "--seed" && i + 1 < argc) seed = static_cast<std::uint32_t>(std::atoi(argv[++i]));
+        else if (arg == "--threads" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else {
+            std::cerr << "Unknown argument " << arg << std::endl;
+            return 2;
+        }
+    }
+    threads = std::max(1, threads);
+
+    Compiler compiler;
+    for (int c = 0; c < PolicyTable::CHARACTERS; ++c) compiler.models[c] = FighterModel::fromPreset(static_cast<CharacterTypeID>(c));
+
+    std::vector<std::uint8_t> bestCells;
+    int bestMargin = std::numeric_limits<int>::min(), bestRound = 0;
+    for (int round = 1; round <= rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::vector<float>> sums(threads, std::vector<float>(PolicyTable::CELLS * AI_OPTION_COUNT, 0.f));
+        std::vector<std::vector<std::uint32_t>> counts(threads, std::vector<std::uint32_t>(PolicyTable::CELLS * AI_OPTION_COUNT, 0));
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            long long share = samples / threads + (t < samples % threads ? 1 : 0);
+            std::uint32_t workerSeed = seed * 7919u + static_cast<std::uint32_t>(round * 131 + t);
+            workers.emplace_back([&, t, share, workerSeed] { compiler.selfPlay(share, workerSeed, sums[t], counts[t]); });
+        }
+        for (std::thread& worker : workers) worker.join();
+        for (int t = 1; t < threads; ++t) {
+            for (std::size_t i = 0; i < sums[0].size(); ++i) {
+                sums[0][i] += sums[t][i];
+                counts[0][i] += counts[t][i];
+            }
+        }
+        int reached = compiler.rebuild(sums[0], counts[0]);
+
+        int wins, losses, draws;
+        compiler.evaluate(100, seed + 17u, wins, losses, draws);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("round %d: %d of %d cells reached, vs greedy %d-%d-%d (W-L-D), %.1f s\n", round, reached,
+                    PolicyTable::CELLS, wins, losses, draws, seconds);
+        if (wins - losses > bestMargin) {
+            bestMargin = wins - losses;
+            bestRound = round;
+            bestCells = compiler.table.cells;
+        }
+    }
+    compiler.table.cells = bestCells;
+
+    if (!compiler.table.save(outPath)) {
+        std::cerr << "Failed to write " << outPath << std::endl;
+        return 1;
+    }
+    std::printf("Wrote %s (%d cells, round %d)\n", outPath.c_str(), PolicyTable::CELLS, bestRound);
+    return 0;
+}